@@ -64,6 +64,30 @@ struct JunkDetectionConfig {
   static JunkDetectionConfig disabled();
 };
 
+struct InProcessSandboxConfig {
+  std::vector<std::string> testFrameworks;
+  std::vector<std::string> tests;
+
+  InProcessSandboxConfig();
+  bool isEnabled() const;
+  bool isEnabledFor(const std::string &testFramework,
+                    const std::string &testName) const;
+};
+
+/// See 'sampling' option
+struct SamplingConfig {
+  /// Number of mutants to run, zero runs all of them
+  int size;
+  /// Zero picks a random seed
+  int seed;
+  /// Width of the confidence interval to stop at, in percentage points.
+  /// Zero runs the whole sample.
+  int intervalWidth;
+
+  SamplingConfig();
+  bool isEnabled() const;
+};
+
 class Config {
 public:
   enum class Fork {
@@ -78,6 +102,36 @@ public:
     Disabled,
     Enabled
   };
+  enum class BatchTestsMode {
+    Disabled,
+    Enabled
+  };
+  enum class InstrumentationMode {
+    Callbacks,
+    Inline
+  };
+  enum class ReachabilityMode {
+    Dynamic,
+    Static,
+    Hybrid,
+    Sampling
+  };
+  enum class BlockCoverageMode {
+    Disabled,
+    Enabled
+  };
+  enum class CallCountsMode {
+    Disabled,
+    Enabled
+  };
+  enum class StreamingMode {
+    Disabled,
+    Enabled
+  };
+  enum class ZygoteMode {
+    Disabled,
+    Enabled
+  };
   enum class UseCache {
     No,
     Yes
@@ -96,6 +150,13 @@ public:
   static std::string forkToString(Fork fork);
   static std::string dryRunToString(DryRunMode dryRun);
   static std::string failFastToString(FailFastMode failFast);
+  static std::string batchTestsToString(BatchTestsMode batchTests);
+  static std::string instrumentationModeToString(InstrumentationMode mode);
+  static std::string reachabilityModeToString(ReachabilityMode mode);
+  static std::string blockCoverageToString(BlockCoverageMode blockCoverage);
+  static std::string callCountsToString(CallCountsMode callCounts);
+  static std::string streamingToString(StreamingMode streaming);
+  static std::string zygoteToString(ZygoteMode zygote);
   static std::string cachingToString(UseCache caching);
   static std::string emitDebugInfoToString(EmitDebugInfo emitDebugInfo);
   static std::string diagnosticsToString(Diagnostics diagnostics);
@@ -116,16 +177,27 @@ private:
   Fork fork;
   DryRunMode dryRun;
   FailFastMode failFast;
+  BatchTestsMode batchTests;
+  ZygoteMode zygote;
+  BlockCoverageMode blockCoverage;
+  CallCountsMode callCounts;
+  StreamingMode streaming;
+  InstrumentationMode instrumentationMode;
+  ReachabilityMode reachabilityMode;
   UseCache caching;
   EmitDebugInfo emitDebugInfo;
   Diagnostics diagnostics;
 
   int timeout;
   int maxDistance;
+  int executionBudget;
+  int timeBudget;
   std::string cacheDirectory;
 
   JunkDetectionConfig junkDetection;
   ParallelizationConfig parallelizationConfig;
+  InProcessSandboxConfig inProcessSandbox;
+  SamplingConfig sampling;
 
   friend llvm::yaml::MappingTraits<mull::Config>;
 public:
@@ -177,16 +249,36 @@ public:
   JunkDetectionConfig &junkDetectionConfig();
   Diagnostics getDiagnostics() const;
   const ParallelizationConfig parallelization() const;
+  const InProcessSandboxConfig &inProcessSandboxConfig() const;
+  const SamplingConfig &samplingConfig() const;
 
   int getTimeout() const;
   int getMaxDistance() const;
+  int getExecutionBudget() const;
+  /// In seconds, see 'time_budget'
+  int getTimeBudget() const;
+  ReachabilityMode getReachabilityMode() const;
 
   bool forkEnabled() const;
   bool cachingEnabled() const;
   bool dryRunModeEnabled() const;
   bool failFastModeEnabled() const;
+  bool batchTestsModeEnabled() const;
+  bool zygoteEnabled() const;
+  bool blockCoverageEnabled() const;
+  bool callCountsEnabled() const;
+  bool streamingEnabled() const;
+  bool inlineInstrumentationEnabled() const;
+  bool staticReachabilityEnabled() const;
+  bool hybridReachabilityEnabled() const;
+  bool samplingReachabilityEnabled() const;
+  /// Not to be confused with 'reachability: sampling', see 'sampling' option
+  bool mutantSamplingEnabled() const;
   bool shouldEmitDebugInfo() const;
   bool junkDetectionEnabled() const;
+  bool executionBudgetEnabled() const;
+  bool timeBudgetEnabled() const;
+  bool inProcessSandboxEnabledFor(const std::string &testName) const;
 
   void normalizeParallelizationConfig();
 
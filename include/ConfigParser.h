@@ -89,6 +89,64 @@ struct ScalarEnumerationTraits<mull::Config::FailFastMode> {
   }
 };
 
+template <>
+struct ScalarEnumerationTraits<mull::Config::BatchTestsMode> {
+  static void enumeration(IO &io, mull::Config::BatchTestsMode &value) {
+    io.enumCase(value, "enabled",  mull::Config::BatchTestsMode::Enabled);
+    io.enumCase(value, "disabled",  mull::Config::BatchTestsMode::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::ZygoteMode> {
+  static void enumeration(IO &io, mull::Config::ZygoteMode &value) {
+    io.enumCase(value, "enabled",  mull::Config::ZygoteMode::Enabled);
+    io.enumCase(value, "disabled",  mull::Config::ZygoteMode::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::CallCountsMode> {
+  static void enumeration(IO &io, mull::Config::CallCountsMode &value) {
+    io.enumCase(value, "enabled",  mull::Config::CallCountsMode::Enabled);
+    io.enumCase(value, "disabled",  mull::Config::CallCountsMode::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::StreamingMode> {
+  static void enumeration(IO &io, mull::Config::StreamingMode &value) {
+    io.enumCase(value, "enabled",  mull::Config::StreamingMode::Enabled);
+    io.enumCase(value, "disabled",  mull::Config::StreamingMode::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::BlockCoverageMode> {
+  static void enumeration(IO &io, mull::Config::BlockCoverageMode &value) {
+    io.enumCase(value, "enabled",  mull::Config::BlockCoverageMode::Enabled);
+    io.enumCase(value, "disabled",  mull::Config::BlockCoverageMode::Disabled);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::InstrumentationMode> {
+  static void enumeration(IO &io, mull::Config::InstrumentationMode &value) {
+    io.enumCase(value, "callbacks",  mull::Config::InstrumentationMode::Callbacks);
+    io.enumCase(value, "inline",  mull::Config::InstrumentationMode::Inline);
+  }
+};
+
+template <>
+struct ScalarEnumerationTraits<mull::Config::ReachabilityMode> {
+  static void enumeration(IO &io, mull::Config::ReachabilityMode &value) {
+    io.enumCase(value, "dynamic",  mull::Config::ReachabilityMode::Dynamic);
+    io.enumCase(value, "static",  mull::Config::ReachabilityMode::Static);
+    io.enumCase(value, "hybrid",  mull::Config::ReachabilityMode::Hybrid);
+    io.enumCase(value, "sampling",  mull::Config::ReachabilityMode::Sampling);
+  }
+};
+
 template <>
 struct ScalarEnumerationTraits<mull::Config::UseCache> {
   static void enumeration(IO &io, mull::Config::UseCache &value) {
@@ -128,6 +186,23 @@ struct MappingTraits<mull::ParallelizationConfig> {
   }
 };
 
+template<>
+struct MappingTraits<mull::InProcessSandboxConfig> {
+  static void mapping(IO &io, mull::InProcessSandboxConfig &config) {
+    io.mapOptional("test_frameworks", config.testFrameworks);
+    io.mapOptional("tests", config.tests);
+  }
+};
+
+template<>
+struct MappingTraits<mull::SamplingConfig> {
+  static void mapping(IO &io, mull::SamplingConfig &config) {
+    io.mapOptional("size", config.size);
+    io.mapOptional("seed", config.seed);
+    io.mapOptional("interval_width", config.intervalWidth);
+  }
+};
+
 template <>
 struct MappingTraits<mull::Config>
 {
@@ -146,14 +221,25 @@ struct MappingTraits<mull::Config>
     io.mapOptional("fork", config.fork);
     io.mapOptional("dry_run", config.dryRun);
     io.mapOptional("fail_fast", config.failFast);
+    io.mapOptional("batch_tests", config.batchTests);
+    io.mapOptional("zygote", config.zygote);
+    io.mapOptional("block_coverage", config.blockCoverage);
+    io.mapOptional("call_counts", config.callCounts);
+    io.mapOptional("streaming", config.streaming);
+    io.mapOptional("instrumentation_mode", config.instrumentationMode);
+    io.mapOptional("reachability", config.reachabilityMode);
     io.mapOptional("use_cache", config.caching);
     io.mapOptional("emit_debug_info", config.emitDebugInfo);
     io.mapOptional("diagnostics", config.diagnostics);
     io.mapOptional("timeout", config.timeout);
     io.mapOptional("max_distance", config.maxDistance);
+    io.mapOptional("execution_budget", config.executionBudget);
+    io.mapOptional("time_budget", config.timeBudget);
     io.mapOptional("cache_directory", config.cacheDirectory);
     io.mapOptional("junk_detection", config.junkDetection);
     io.mapOptional("parallelization", config.parallelizationConfig);
+    io.mapOptional("in_process_sandbox", config.inProcessSandbox);
+    io.mapOptional("sampling", config.sampling);
   }
 };
 }
@@ -30,6 +30,8 @@ public:
   void addModule(std::unique_ptr<MullModule> module);
 
   std::vector<llvm::Function *> getStaticConstructors();
+  /// The static constructors of one module, in the order of the module
+  static std::vector<llvm::Function *> getStaticConstructors(llvm::Module *module);
 
   MullModule *moduleWithIdentifier(const std::string &identifier);
   MullModule *moduleWithIdentifier(const std::string &identifier) const;
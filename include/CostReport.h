@@ -0,0 +1,52 @@
+#pragma once
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class MutantCostModel;
+class MutationPoint;
+
+/// Predicted cost of a group of mutants, in milliseconds
+struct CostEstimate {
+  size_t mutants;
+  double compileTime;
+  double executionTime;
+
+  CostEstimate() : mutants(0), compileTime(0), executionTime(0) {}
+
+  double total() const { return compileTime + executionTime; }
+};
+
+/// What running the mutants would cost, reported by 'dry_run'.
+///
+/// Each mutant is priced by MutantCostModel. The costs are summed per module
+/// and per mutator, and the wall time is projected for the given number of
+/// workers: the mutants are split into the same contiguous batches the
+/// workers get when the mutants are run, and the slowest batch wins.
+class CostReport {
+public:
+  CostReport(const std::vector<MutationPoint *> &points,
+             MutantCostModel &costModel, size_t workers);
+
+  const CostEstimate &getTotal() const;
+  const std::map<std::string, CostEstimate> &getModules() const;
+  const std::map<std::string, CostEstimate> &getMutators() const;
+  double getProjectedWallTime() const;
+
+  void print(llvm::raw_ostream &out) const;
+
+private:
+  size_t workers;
+  CostEstimate total;
+  std::map<std::string, CostEstimate> modules;
+  std::map<std::string, CostEstimate> mutators;
+  double projectedWallTime;
+};
+
+}
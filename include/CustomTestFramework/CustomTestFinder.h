@@ -2,6 +2,7 @@
 
 #include "TestFinder.h"
 
+#include <map>
 #include <vector>
 
 namespace mull {
@@ -10,12 +11,20 @@ class Context;
 class Filter;
 struct CustomTestDefinition;
 
-class CustomTestFinder : public TestFinder {
+class CustomTestFinder : public ModuleTestFinder {
   const std::vector<CustomTestDefinition> &testDefinitions;
+  /// Index of the definition, by method name
+  std::map<std::string, size_t> testMapping;
 public:
-  CustomTestFinder(const std::vector<CustomTestDefinition> &definitions);
-  std::vector<std::unique_ptr<Test>> findTests(Context &context,
-                                               Filter &filter) override;
+  CustomTestFinder(const std::vector<CustomTestDefinition> &definitions,
+                   int workers = 1, const std::string &cacheDirectory = "");
+
+  std::vector<DiscoveredTest> discoverTests(llvm::Module *module) override;
+  std::string discoveryKey() const override;
+  std::unique_ptr<Test> createTest(const DiscoveredTest &test,
+                                   llvm::Function *entryPoint,
+                                   const std::vector<llvm::Function *> &constructors,
+                                   Filter &filter) override;
 };
 
 }
@@ -10,9 +10,11 @@
 #include "Instrumentation/Instrumentation.h"
 #include "Test.h"
 #include "Toolchain/Toolchain.h"
+#include "Zygote.h"
 
 #include <llvm/Object/ObjectFile.h>
 
+#include <chrono>
 #include <map>
 
 namespace llvm {
@@ -33,6 +35,11 @@ class TestRunner;
 class MutationsFinder;
 class Metrics;
 class JunkDetector;
+class ReachabilityCache;
+class SamplingProfiler;
+class JITEngine;
+class MergedTestee;
+class MutationSampler;
 
 class Driver {
   Config &config;
@@ -51,8 +58,14 @@ class Driver {
   std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> instrumentedObjectFiles;
   std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> ownedObjectFiles;
   Instrumentation instrumentation;
+  std::vector<std::unique_ptr<Zygote>> zygotes;
+  std::unique_ptr<ReachabilityCache> reachabilityCache;
+  /// See 'reachability: sampling', false when sampling is not available
+  bool samplingReachability;
   Metrics &metrics;
   JunkDetector &junkDetector;
+  /// See 'time_budget'
+  std::chrono::steady_clock::time_point startTime;
 public:
   Driver(Config &C,
          ModuleLoader &ML,
@@ -72,15 +85,39 @@ public:
   std::vector<llvm::object::ObjectFile *> AllButOne(llvm::Module *One);
 private:
   void loadBitcodeFilesIntoMemory();
-  void compileInstrumentedBitcodeFiles();
+  void compileInstrumentedBitcodeFiles(const std::vector<std::unique_ptr<Test>> &tests);
   void loadPrecompiledObjectFiles();
   void loadDynamicLibraries();
+  void startZygotes();
+  /// False when the testees can be found without running the instrumented
+  /// tests, see ReachabilityCache and 'reachability' option
+  bool needsInstrumentedProgram(const std::vector<std::unique_ptr<Test>> &tests);
+  bool originalTestResultsCached(const std::vector<std::unique_ptr<Test>> &tests);
+  void compileOriginalBitcodeFiles();
+  /// Loads the uninstrumented original program, see 'reachability: sampling'
+  std::unique_ptr<SamplingProfiler> loadSampledProgram(JITEngine &jit);
 
   std::vector<std::unique_ptr<Test>> findTests();
   std::vector<MutationPoint *> findMutationPoints(std::vector<std::unique_ptr<Test>> &tests);
+  std::vector<MergedTestee> findTestees(std::vector<std::unique_ptr<Test>> &tests);
+  /// Finds, filters and runs the mutants a batch of testees at a time,
+  /// see 'streaming' option
+  void streamMutations(std::vector<std::unique_ptr<Test>> &tests,
+                       std::vector<MutationPoint *> &nonJunkMutationPoints,
+                       std::vector<std::unique_ptr<MutationResult>> &mutationResults);
+  std::vector<std::unique_ptr<Testee>> runOriginalTests(std::vector<std::unique_ptr<Test>> &tests);
+  std::vector<std::unique_ptr<Testee>> findStaticTestees(std::vector<std::unique_ptr<Test>> &tests);
   std::vector<MutationPoint *> filterOutJunkMutations(std::vector<MutationPoint *> mutationPoints);
 
   std::vector<std::unique_ptr<MutationResult>> runMutations(std::vector<MutationPoint *> &mutationPoints);
+  /// Runs a sample of the mutants, see 'sampling' option. Leaves only the
+  /// mutants that have been run in 'mutationPoints'.
+  std::vector<std::unique_ptr<MutationResult>> runSampledMutations(std::vector<MutationPoint *> &mutationPoints,
+                                                                   MutationSampler &sampler);
+  /// Runs the mutants that fit into 'time_budget', the rest of them get
+  /// 'Skipped' results
+  std::vector<std::unique_ptr<MutationResult>> runBudgetedMutations(const std::vector<MutationPoint *> &mutationPoints);
+  std::vector<std::unique_ptr<MutationResult>> executeMutations(const std::vector<MutationPoint *> &mutationPoints);
 
   std::vector<llvm::object::ObjectFile *> AllInstrumentedObjectFiles();
 
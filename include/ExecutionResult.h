@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace mull {
@@ -11,16 +12,20 @@ namespace mull {
     Crashed = 4,
     AbnormalExit = 5,
     DryRun = 6,
-    FailFast = 7
+    FailFast = 7,
+    NotCovered = 8,
+    Skipped = 9
   };
 
   struct ExecutionResult {
     ExecutionStatus status;
     int exitStatus;
     long long runningTime;
+    /// Function calls and loop iterations, see ExecutionBudget
+    uint64_t executionSteps;
     std::string stdoutOutput;
     std::string stderrOutput;
-    ExecutionResult() : status(ExecutionStatus::Invalid), exitStatus(0), runningTime(0) {}
+    ExecutionResult() : status(ExecutionStatus::Invalid), exitStatus(0), runningTime(0), executionSteps(0) {}
 
     std::string getStatusAsString() {
       switch (this->status) {
@@ -40,6 +45,10 @@ namespace mull {
           return "DryRun";
         case FailFast:
           return "FailFast";
+        case NotCovered:
+          return "NotCovered";
+        case Skipped:
+          return "Skipped";
       }
     }
   };
@@ -1,13 +1,27 @@
 #pragma once
 
+#include "PatternMatcher.h"
+
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Instruction.h>
 
+namespace llvm {
+class DIFile;
+}
+
 namespace mull {
 
+/// The name and location patterns are substrings, or regular expressions
+/// prefixed with 'regex:', see PatternMatcher.
+///
+/// The verdicts are memoized per function and per source file, so each of
+/// them is matched against the patterns once per run. The patterns must be
+/// added before anything is checked. The checks may run in parallel.
 class Filter {
 public:
   bool shouldSkipFunction(llvm::Function *function);
@@ -23,9 +37,16 @@ public:
   void includeTest(const std::string &testName);
   void includeTest(const char *testName);
 private:
-  std::vector<std::string> names;
-  std::vector<std::string> locations;
+  bool shouldSkipFile(const llvm::DIFile *file);
+  bool shouldSkipPath(const std::string &filePath);
+
+  PatternMatcher names;
+  PatternMatcher locations;
   std::vector<std::string> tests;
+
+  std::mutex verdictsMutex;
+  llvm::DenseMap<const llvm::Function *, bool> functionVerdicts;
+  llvm::DenseMap<const llvm::DIFile *, bool> fileVerdicts;
 };
 
 }
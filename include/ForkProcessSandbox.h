@@ -1,3 +1,4 @@
+#pragma once
 
 #include <functional>
 #include "ExecutionResult.h"
@@ -18,6 +19,10 @@ public:
 
   ExecutionResult run(std::function<ExecutionStatus ()> function,
                       long long timeoutMilliseconds);
+
+  /// Restarts the timeout of the running child process. May be called only
+  /// from within the function passed to 'run'.
+  static void restartTimeout(long long timeoutMilliseconds);
 };
 
 class NullProcessSandbox : public ProcessSandbox {
@@ -26,4 +31,23 @@ public:
                       long long timeoutMilliseconds);
 };
 
+/// Runs the function in the calling thread, but survives crashes and hangs.
+///
+/// SIGSEGV, SIGBUS, SIGILL, SIGFPE, and SIGABRT are handled on an alternate
+/// signal stack and turned into the 'Crashed' status by jumping back into
+/// 'run' using siglongjmp. Timeouts are enforced by a per-thread timer and
+/// reported as 'Timedout'.
+///
+/// Suitable only for short tests without side effects: a test interrupted
+/// this way leaks everything it allocated and may leave locks held.
+/// Output of the test is not captured.
+class InProcessSandbox : public ProcessSandbox {
+public:
+  ExecutionResult run(std::function<ExecutionStatus ()> function,
+                      long long timeoutMilliseconds);
+
+  /// Per-thread timers are only available on Linux
+  static bool isSupported();
+};
+
 }
@@ -9,10 +9,16 @@ namespace mull {
 class Context;
 class Filter;
 
-class GoogleTestFinder : public TestFinder {
+class GoogleTestFinder : public ModuleTestFinder {
 public:
-  std::vector<std::unique_ptr<Test>> findTests(Context &context,
-                                               Filter &filter) override;
+  GoogleTestFinder(int workers = 1, const std::string &cacheDirectory = "");
+
+  std::vector<DiscoveredTest> discoverTests(llvm::Module *module) override;
+  std::string discoveryKey() const override;
+  std::unique_ptr<Test> createTest(const DiscoveredTest &test,
+                                   llvm::Function *entryPoint,
+                                   const std::vector<llvm::Function *> &constructors,
+                                   Filter &filter) override;
 };
 
 }
@@ -10,6 +10,8 @@
 #include <llvm/Object/ObjectFile.h>
 #include <llvm/Target/TargetMachine.h>
 
+#include <sys/types.h>
+
 namespace llvm {
 
 class Function;
@@ -19,6 +21,7 @@ class Function;
 namespace mull {
 
 struct InstrumentationInfo;
+class GoogleTest_Test;
 
 class GoogleTestRunner : public TestRunner {
   Mangler mangler;
@@ -27,7 +30,15 @@ class GoogleTestRunner : public TestRunner {
   std::string fGoogleTestInit;
   std::string fGoogleTestInstance;
   std::string fGoogleTestRun;
+  std::string fGoogleTestFilterFlag;
   InstrumentationInfo **trampoline;
+
+  /// The static constructors of the loaded program have run and Google Test
+  /// is initialized, see 'startProgram'
+  bool programStarted;
+  /// The process that has loaded the program, the tests run in it keep the
+  /// static objects for the next tests
+  pid_t programProcess;
 public:
 
   GoogleTestRunner(llvm::TargetMachine &machine);
@@ -37,11 +48,19 @@ public:
   void loadProgram(ObjectFiles &objectFiles, JITEngine &jit) override;
   ExecutionStatus runTest(Test *test, JITEngine &jit) override;
 
+  bool supportsBatchExecution() const override;
+  void runTests(TestBatch &batch, JITEngine &jit) override;
+
 private:
   void *getConstructorPointer(const llvm::Function &function, JITEngine &jit);
   void *getFunctionPointer(const std::string &functionName, JITEngine &jit);
 
   void runStaticConstructor(llvm::Function *constructor, JITEngine &jit);
+
+  void startProgram(GoogleTest_Test *test, JITEngine &jit);
+  void finishTests();
+  void finishProgram();
+  std::string *filterFlag(JITEngine &jit);
 };
 
 }
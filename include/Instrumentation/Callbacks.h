@@ -3,18 +3,33 @@
 #include <cstdint>
 
 namespace llvm {
+  class BasicBlock;
   class Function;
+  class Instruction;
   class Module;
   class Value;
 }
 
 namespace mull {
 
+  struct InstrumentationInfo;
+
   extern "C" void mull_enterFunction(void **trampoline, uint32_t functionIndex);
   extern "C" void mull_leaveFunction(void **trampoline, uint32_t functionIndex);
 
   class Callbacks {
   public:
+    /// Makes the calling thread record the call tree into 'info'.
+    /// The threads started by the test use the trampoline, which is set
+    /// to 'info' as well.
+    static void setInstrumentationInfo(InstrumentationInfo **trampoline,
+                                       InstrumentationInfo *info);
+
+    /// Static allocas must stay in the entry block, hence the code on entry
+    /// goes right after them. The allocas are not necessarily first, e.g.
+    /// when the function is already instrumented.
+    static llvm::Instruction *firstInstructionAfterAllocas(llvm::BasicBlock &entryBlock);
+
     void injectCallbacks(llvm::Function *function,
                          uint32_t index,
                          llvm::Value *infoPointer,
@@ -25,5 +40,33 @@ namespace mull {
 
     llvm::Value *injectFunctionIndexOffset(llvm::Module *module,
                                            const char *functionIndexOffsetPrefix);
+
+    llvm::Value *injectBlockIndexOffset(llvm::Module *module,
+                                        const char *blockIndexOffsetPrefix);
+
+    /// Records the call tree with inline code instead of calling
+    /// mull_enterFunction and mull_leaveFunction
+    ///
+    /// Every thread updates the same 'InstrumentationInfo::currentFunction',
+    /// so the call trees of tests that start threads are approximate: the
+    /// parent links recorded by concurrent threads interleave
+    void injectInlineCallTree(llvm::Function *function,
+                              uint32_t index,
+                              llvm::Value *infoPointer,
+                              llvm::Value *offset);
+
+    /// Counts the calls of the function in 'InstrumentationInfo::callCounts'
+    void injectCallCounter(llvm::Function *function,
+                           uint32_t index,
+                           llvm::Value *infoPointer,
+                           llvm::Value *offset);
+
+    /// Marks each basic block of the function as executed in
+    /// 'InstrumentationInfo::blockCoverage'. The block 'i' of the function
+    /// gets the index 'blockOffset + firstBlockIndex + i'.
+    void injectBlockCoverage(llvm::Function *function,
+                             uint32_t firstBlockIndex,
+                             llvm::Value *infoPointer,
+                             llvm::Value *blockOffset);
   };
 }
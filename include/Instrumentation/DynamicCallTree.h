@@ -28,6 +28,42 @@ namespace mull {
     CallTreeFunction(llvm::Function *f) : function(f), treeRoot(nullptr) {}
   };
 
+/// Call trees of a test stored as flat arrays indexed by function index.
+///
+/// Children of the function N are stored in
+/// 'children[firstChild[N]] ... children[firstChild[N + 1] - 1]', the roots
+/// of the forest are the children of the phony function 0.
+///
+/// The forest is built in linear time straight from the call tree mapping,
+/// see DynamicCallTree::createCallTree for its format. The arrays are reused
+/// between the tests, so that one forest per thread allocates nothing after
+/// the first few tests.
+class CallForest {
+public:
+  CallForest();
+
+  void build(const uint32_t *mapping, size_t functionsCount);
+
+  /// Indices of all the functions set in the mapping: each of them is
+  /// a child of its caller or of the phony root
+  const std::vector<uint32_t> &calledFunctions() const;
+
+  /// Functions reachable from the entry points of the test, with their
+  /// distance from the entry point, in breadth-first order.
+  /// The subtree of a function skipped by the filter is skipped as well.
+  std::vector<std::unique_ptr<Testee>>
+  createTestees(const std::vector<CallTreeFunction> &functions, Test *test,
+                int maxDistance, Filter &filter);
+
+private:
+  const uint32_t *mapping;
+  size_t functionsCount;
+  std::vector<uint32_t> firstChild;
+  std::vector<uint32_t> children;
+  /// Function index and its distance
+  std::vector<std::pair<uint32_t, int>> queue;
+};
+
 /// TODO: What is the good practice for this? maybe namespace?
 class DynamicCallTree {
 public:
@@ -47,6 +83,18 @@ public:
   static void leaveFunction(const uint32_t functionIndex,
                             uint32_t *mapping,
                             std::stack<uint32_t> &stack);
+
+  /// Same as above, but safe to call from several threads sharing
+  /// the mapping, each with its own stack.
+  /// When the stack is empty the function is attached to 'threadParent',
+  /// e.g. a function a thread was started from. Zero makes it a root.
+  static void enterFunction(const uint32_t functionIndex,
+                            uint32_t *mapping,
+                            std::vector<uint32_t> &stack,
+                            uint32_t threadParent);
+  static void leaveFunction(const uint32_t functionIndex,
+                            uint32_t *mapping,
+                            std::vector<uint32_t> &stack);
 };
 
 }
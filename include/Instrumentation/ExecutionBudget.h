@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+namespace llvm {
+  class Function;
+  class Module;
+}
+
+namespace mull {
+
+  extern "C" uint64_t mull_execution_budget_counter;
+  extern "C" uint64_t mull_execution_budget_limit;
+  extern "C" void mull_executionBudgetExceeded();
+
+  /// Counts function calls and loop iterations of a test.
+  ///
+  /// The counters make it possible to detect a mutant stuck in an infinite
+  /// loop without relying on wall-clock time: the original run of a test
+  /// records the number of steps, and a mutant that takes a given multiple
+  /// of that number is terminated and reported as timed out.
+  ///
+  /// The counter and the limit are plain globals of the process running a
+  /// test, hence the budget is only meaningful when each test runs in its own
+  /// process (see 'fork' option). The tests run by InProcessSandbox share
+  /// them with the Mull process: they are run without a budget, and
+  /// the Mull process itself never arms it.
+  class ExecutionBudget {
+  public:
+    /// Mutants are never given less than this number of steps
+    static const uint64_t MinimalLimit = 1000;
+
+    /// Inserts the counters on the entry of each function and on each
+    /// loop back edge of the module.
+    static void insertCounters(llvm::Module *module);
+
+    /// Resets the counter and sets the limit. Zero means no limit.
+    static void arm(uint64_t limit);
+
+    /// Number of steps made since the last call to 'arm'
+    static uint64_t steps();
+
+    /// The limit for a mutant of a test that made 'originalSteps' steps,
+    /// saturated at the largest limit
+    static uint64_t limitFor(uint64_t originalSteps, int multiplier);
+
+  private:
+    static void insertCounters(llvm::Function *function);
+  };
+}
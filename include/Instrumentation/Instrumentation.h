@@ -2,11 +2,15 @@
 
 #include "Instrumentation/Callbacks.h"
 #include "Instrumentation/DynamicCallTree.h"
+#include "Instrumentation/InstrumentationBuffers.h"
 #include "Testee.h"
 
+#include <map>
+#include <unordered_set>
 #include <vector>
 
 namespace llvm {
+  class BasicBlock;
   class Module;
 }
 
@@ -17,23 +21,67 @@ namespace mull {
 
   class Instrumentation {
   public:
-    Instrumentation();
+    /// With 'blockCoverage' the instrumented code also records which basic
+    /// blocks are executed by each test, see 'block_coverage' option.
+    /// With 'inlineCallTree' the call tree is recorded by inline code instead
+    /// of the callbacks, see 'instrumentation_mode' option.
+    /// With 'callCounts' the calls of each function are counted as well,
+    /// see 'call_counts' option.
+    explicit Instrumentation(bool blockCoverage = false, bool inlineCallTree = false,
+                             bool callCounts = false);
 
     void recordFunctions(llvm::Module *originalModule);
     void insertCallbacks(llvm::Module *instrumentedModule);
 
-    std::vector<std::unique_ptr<Testee>> getTestees(Test *test, Filter &filter, int distance);
+    /// Restricts the call tree instrumentation to the given functions of the
+    /// original modules, see 'reachability: hybrid'.
+    /// Must be called after all the functions are recorded.
+    void instrumentOnly(const std::unordered_set<llvm::Function *> &functions);
+    bool instrumentsAllFunctions() const;
+
+    /// 'forest' is a scratch space, reused between the tests of one thread
+    std::vector<std::unique_ptr<Testee>> getTestees(Test *test, Filter &filter, int distance,
+                                                    CallForest &forest);
+    /// Stores the blocks executed by the test in the test itself.
+    /// Returns the indices of the blocks in InstrumentationInfo::blockCoverage
+    std::vector<uint32_t> recordCoveredBlocks(Test *test);
+    /// Stores the call counts of the functions in the forest, which must be
+    /// built for the test, in the test itself
+    void recordCallCounts(Test *test, const CallForest &forest);
 
     void setupInstrumentationInfo(Test *test);
     void cleanupInstrumentationInfo(Test *test);
 
+    /// Buffers sized for the recorded functions and blocks,
+    /// to be reused by the tests of one worker
+    std::unique_ptr<InstrumentationBuffers> createBuffers();
+    /// Same as above, but the test writes into the buffers,
+    /// which are reset for the next test on cleanup
+    void setupInstrumentationInfo(Test *test, InstrumentationBuffers &buffers);
+    void cleanupInstrumentationInfo(Test *test, InstrumentationBuffers &buffers);
+
+    /// Recorded functions, indexed the same way as the call tree mapping
+    const std::vector<CallTreeFunction> &getFunctions() const;
     std::map<std::string, uint32_t> &getFunctionOffsetMapping();
+    std::map<std::string, uint32_t> &getBlockOffsetMapping();
 
     const char *instrumentationInfoVariableName();
     const char *functionIndexOffsetPrefix();
+    const char *blockIndexOffsetPrefix();
   private:
     Callbacks callbacks;
     std::vector<CallTreeFunction> functions;
     std::map<std::string, uint32_t> functionOffsetMapping;
+    /// Indexed the same way as 'functions', empty when all the functions
+    /// are instrumented
+    std::vector<bool> instrumentedFunctions;
+
+    bool blockCoverage;
+    bool inlineCallTree;
+    bool callCounts;
+    /// Basic blocks of the original modules, indexed the same way
+    /// as 'InstrumentationInfo::blockCoverage'
+    std::vector<llvm::BasicBlock *> blocks;
+    std::map<std::string, uint32_t> blockOffsetMapping;
   };
 }
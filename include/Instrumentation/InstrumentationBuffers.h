@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mull {
+
+/// Shared memory the instrumented code of a test writes into: the call tree
+/// mapping, the block coverage and the call counts, see InstrumentationInfo.
+///
+/// The buffers are mapped once per worker and reused by all of its tests,
+/// instead of mapping fresh memory for each test. After a test only the
+/// entries it has written are cleared: Mull reads the results of the test
+/// anyway, and tells the buffers which entries it has found set. When it did
+/// not, e.g. the test has failed, the buffers are cleared as a whole.
+class InstrumentationBuffers {
+public:
+  InstrumentationBuffers(size_t functionsCount, size_t blocksCount,
+                         bool callCounts);
+  ~InstrumentationBuffers();
+
+  InstrumentationBuffers(const InstrumentationBuffers &) = delete;
+  InstrumentationBuffers &operator=(const InstrumentationBuffers &) = delete;
+
+  uint32_t *getCallTreeMapping() const;
+  /// Null when the block coverage is not recorded
+  uint8_t *getBlockCoverage() const;
+  /// Null when the calls are not counted
+  uint64_t *getCallCounts() const;
+
+  /// The only entries set by the last test, see CallForest::calledFunctions
+  void setTouchedFunctions(const std::vector<uint32_t> &indices);
+  void setTouchedBlocks(const std::vector<uint32_t> &indices);
+
+  /// Clears the entries written by the last test
+  void reset();
+
+private:
+  size_t functionsCount;
+  size_t blocksCount;
+  uint32_t *callTreeMapping;
+  uint8_t *blockCoverage;
+  uint64_t *callCounts;
+
+  std::vector<uint32_t> touchedFunctions;
+  bool touchedFunctionsKnown;
+  std::vector<uint32_t> touchedBlocks;
+  bool touchedBlocksKnown;
+};
+
+}
@@ -1,12 +1,25 @@
 #pragma once
 
 #include <cstdint>
-#include <stack>
 
 namespace mull {
+/// The instrumented code accesses the fields directly, so they must stay
+/// in place, see Callbacks::injectBlockCoverage,
+/// Callbacks::injectInlineCallTree and Callbacks::injectCallCounter
+///
+/// The call stacks are kept per thread by the callbacks, see Callbacks.cpp
 struct InstrumentationInfo {
-  InstrumentationInfo() : callTreeMapping(nullptr), callstack() {}
+  InstrumentationInfo()
+      : callTreeMapping(nullptr), blockCoverage(nullptr), currentFunction(0),
+        callCounts(nullptr) {}
   uint32_t *callTreeMapping;
-  std::stack<uint32_t> callstack;
+  /// One byte per basic block, set to 1 once the block is executed
+  uint8_t *blockCoverage;
+  /// The top of the call stack of the thread running the test,
+  /// zero when the stack is empty
+  uint32_t currentFunction;
+  /// Number of calls of each function, indexed the same way as
+  /// 'callTreeMapping', see 'call_counts' option
+  uint64_t *callCounts;
 };
 }
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ExecutionResult.h"
+#include "Instrumentation/DynamicCallTree.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace llvm {
+  class Function;
+  class Module;
+}
+
+namespace mull {
+
+  class JITEngine;
+  class Test;
+
+  /// Outcome of profiling one test.
+  /// Stored in shared memory, hence it must stay a plain struct.
+  struct SamplingStatistics {
+    uint64_t samples;
+    int runs;
+    /// Running time of the first run, in milliseconds
+    long long runningTime;
+  };
+
+  /// Finds the functions reached by a test without instrumenting them,
+  /// see 'reachability: sampling'.
+  ///
+  /// The original test is run while the kernel samples its call stacks
+  /// (perf_event_open, the user-space call chains are walked by frame
+  /// pointers, hence the original code is compiled with frame pointers).
+  /// Each address of a sampled call chain is mapped back to the JIT-ed
+  /// function containing it, and the chain is stored into the call tree
+  /// mapping of the test as if its functions were entered one after another.
+  /// The testees are then extracted the same way as for instrumented tests.
+  ///
+  /// A short test gets only a few samples, so it is rerun within the same
+  /// process until it gets 'TargetSamples' samples, or until it runs out of
+  /// runs or time. Functions that run for less than a sampling period may be
+  /// missed anyway: the reachability is approximate.
+  class SamplingProfiler {
+  public:
+    static const uint64_t TargetSamples = 256;
+    static const int MaxRuns = 64;
+    /// In nanoseconds of the task clock
+    static const uint64_t SamplingPeriod = 100000;
+
+    /// Whether the kernel lets Mull sample its own call stacks
+    static bool isSupported();
+
+    /// Makes the code generator keep frame pointers in the module,
+    /// otherwise the call chains cannot be walked
+    static void keepFramePointers(llvm::Module *module);
+
+    /// Statistics to be shared with the process running the test
+    static std::shared_ptr<SamplingStatistics> createStatistics();
+
+    /// Maps 'functions' (see Instrumentation::getFunctions) to their
+    /// addresses in the program loaded by the 'jit'
+    SamplingProfiler(const std::vector<CallTreeFunction> &functions,
+                     JITEngine &jit);
+
+    /// Runs the test as described above and records the sampled call chains
+    /// into its call tree mapping. Must be called within the process that
+    /// runs the test. The test is not rerun after 'timeBudget' milliseconds
+    /// or after a run that did not pass.
+    /// Returns the status of the first run.
+    ExecutionStatus profile(Test *test, const std::function<ExecutionStatus()> &run,
+                            long long timeBudget, SamplingStatistics &statistics) const;
+
+    /// Index of the function containing the address, zero if there is none
+    uint32_t functionAt(uint64_t address) const;
+
+  private:
+    struct AddressRange {
+      uint64_t begin;
+      uint64_t end;
+      uint32_t functionIndex;
+
+      bool operator<(const AddressRange &other) const {
+        return begin < other.begin;
+      }
+    };
+
+    /// Indexed the same way as the call tree mapping
+    std::vector<llvm::Function *> functions;
+    std::vector<AddressRange> ranges;
+  };
+}
@@ -6,6 +6,7 @@
 #include <map>
 #include <string>
 #include <mutex>
+#include <thread>
 #include <clang-c/Index.h>
 
 #include <clang/Tooling/CompilationDatabase.h>
@@ -15,6 +16,9 @@ namespace mull {
 class MutationPoint;
 struct JunkDetectionConfig;
 
+/// Each thread parses the translation units with its own CXIndex, and the
+/// parsing is not serialized: the mutation points of one source file must not
+/// be checked from several threads at once, see JunkDetectionTask.
 class CXXJunkDetector : public JunkDetector {
 public:
   CXXJunkDetector(JunkDetectionConfig &config);
@@ -22,16 +26,18 @@ public:
 
   bool isJunk(MutationPoint *point) override;
 private:
+  /// Guards the indexes and the units, but not the parsing
   std::mutex mutex;
   std::pair<CXCursor, CXSourceLocation> cursorAndLocation(MutationPoint *point);
   CXTranslationUnit translationUnit(const SourceLocation &location, const std::string &sourceFile);
+  CXIndex threadIndex();
 
   bool isJunkBoundary(CXCursor cursor, CXSourceLocation location, MutationPoint *point);
   bool isJunkMathAdd(CXCursor cursor, CXSourceLocation location, MutationPoint *point);
   bool isJunkNegate(CXCursor cursor, CXSourceLocation location, MutationPoint *point);
   bool isJunkRemoveVoid(CXCursor cursor, CXSourceLocation location, MutationPoint *point);
 
-  CXIndex index;
+  std::map<std::thread::id, CXIndex> indexes;
   std::map<std::string, CXTranslationUnit> units;
   std::unique_ptr<clang::tooling::CompilationDatabase> compdb;
   std::vector<std::string> compilationFlags;
@@ -1,7 +1,11 @@
 #pragma once 
 
+#include <mutex>
+#include <vector>
 #include <string>
 
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringSet.h>
 #include <llvm/IR/Module.h>
 
 namespace llvm {
@@ -10,10 +14,18 @@ class LLVMContext;
 
 namespace mull {
 
+  class MutationPointAddress;
+
   class MullModule {
     std::unique_ptr<llvm::Module> module;
     std::string uniqueIdentifier;
     std::string modulePath;
+    std::mutex stringsMutex;
+    llvm::StringSet<> strings;
+    std::mutex functionsMutex;
+    std::vector<llvm::Function *> functions;
+    llvm::DenseMap<llvm::Function *, int> functionIndices;
+    void indexFunctions();
     MullModule(std::unique_ptr<llvm::Module> llvmModule);
   public:
     MullModule(std::unique_ptr<llvm::Module> llvmModule,
@@ -39,6 +51,20 @@ namespace mull {
     std::string getUniqueIdentifier() const {
       return uniqueIdentifier;
     }
+
+    /// A copy of the string owned by the module, shared by all the equal
+    /// strings, e.g. the paths of the mutation points in the module.
+    /// Valid as long as the module is.
+    llvm::StringRef internString(llvm::StringRef string);
+
+    /// Position of the function in the module, see MutationPointAddress.
+    /// The positions are indexed on first use, instead of walking the
+    /// module on each call.
+    int getFunctionIndex(llvm::Function *function);
+    llvm::Function *getFunction(int index);
+
+    /// The instruction at the address, found through the function index
+    llvm::Instruction &findInstruction(const MutationPointAddress &address);
   };
 
 }
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <cstddef>
+
+namespace mull {
+
+class MullModule;
+class MutationPoint;
+class Test;
+
+/// Predicted time it takes to compile and run a mutant, in milliseconds,
+/// see 'time_budget'.
+///
+/// The compilation of a mutant is predicted from the number of instructions
+/// of the mutated module: the whole module is compiled for each mutant.
+/// The execution is the sum of the running times of the original tests the
+/// mutant is run against. With 'fail_fast' the tests after the first failed
+/// one are not run: each test is assumed to fail with the same probability,
+/// so a test runs only if all the tests before it have passed.
+class MutantCostModel {
+public:
+  /// Code generation time per instruction of the mutated module
+  static constexpr double CompileTimePerInstruction = 0.01;
+  /// Running time of a test whose original run was not timed,
+  /// e.g. with 'reachability: static'
+  static constexpr double UnknownTestRunningTime = 100;
+  /// Probability that a test fails on a mutant, see 'fail_fast' above
+  static constexpr double TestFailureProbability = 0.25;
+
+  explicit MutantCostModel(bool failFast = false);
+
+  static double testRunningTime(Test *test);
+  /// Probability that the test at 'position' among the reachable tests of
+  /// a mutant is run at all
+  static double testRunProbability(size_t position, bool failFast);
+
+  double compileTime(MutationPoint *point);
+  double executionTime(MutationPoint *point);
+  double cost(MutationPoint *point);
+
+  /// Number of instructions, counted once per module
+  size_t moduleSize(MullModule *module);
+
+private:
+  bool failFast;
+  llvm::DenseMap<MullModule *, size_t> moduleSizes;
+};
+
+}
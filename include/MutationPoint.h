@@ -5,8 +5,11 @@
 #include <memory>
 #include <vector>
 
+#include "ReachableTests.h"
 #include "SourceLocation.h"
 
+#include <llvm/ADT/StringRef.h>
+
 namespace llvm {
 
 class Function;
@@ -32,31 +35,17 @@ class MutationPointAddress {
   int BBIndex;
   int IIndex;
 
-  std::string identifier;
 public:
   MutationPointAddress(int FnIndex, int BBIndex, int IIndex) :
-    FnIndex(FnIndex), BBIndex(BBIndex), IIndex(IIndex) {
-
-    identifier = std::to_string(FnIndex) + "_" +
-      std::to_string(BBIndex) + "_" +
-      std::to_string(IIndex);
-  }
-
-  int getFnIndex() { return FnIndex; }
-  int getBBIndex() { return BBIndex; }
-  int getIIndex() { return IIndex; }
+    FnIndex(FnIndex), BBIndex(BBIndex), IIndex(IIndex) {}
 
-  std::string getIdentifier() {
-    return identifier;
-  }
+  int getFnIndex() const { return FnIndex; }
+  int getBBIndex() const { return BBIndex; }
+  int getIIndex() const { return IIndex; }
 
-  std::string getIdentifier() const {
-    return identifier;
-  }
+  /// Computed on each call, the address does not store it
+  std::string getIdentifier() const;
 
-  llvm::Instruction &findInstruction(llvm::Module *module);
-
-  static int getFunctionIndex(llvm::Function *function);
   static
   void enumerateInstructions(llvm::Function &function,
                              const std::function <void (llvm::Instruction &,
@@ -64,46 +53,56 @@ public:
                                                         int)>& block);
 };
 
+/// There may be millions of mutation points, hence a point keeps only what
+/// cannot be recomputed: the unique identifier and the diagnostics are built
+/// on demand, and the paths of the source location are interned in the module.
 class MutationPoint {
   Mutator *mutator;
   MutationPointAddress Address;
   llvm::Value *OriginalValue;
   MullModule *module;
-  std::string uniqueIdentifier;
-  std::string diagnostics;
-  const SourceLocation sourceLocation;
-  std::vector<std::pair<Test *, int>> reachableTests;
+  /// See MullModule::internString
+  llvm::StringRef directory;
+  llvm::StringRef filePath;
+  int line;
+  int column;
+  std::shared_ptr<const ReachableTests> reachableTests;
 public:
   MutationPoint(Mutator *mutator,
                 MutationPointAddress Address,
                 llvm::Value *Val,
                 MullModule *m,
-                std::string diagnostics,
                 const SourceLocation &location);
 
   ~MutationPoint();
 
   Mutator *getMutator();
-  MutationPointAddress getAddress();
+  const MutationPointAddress &getAddress();
   llvm::Value *getOriginalValue();
   MullModule *getOriginalModule();
 
   Mutator *getMutator() const;
-  MutationPointAddress getAddress() const;
+  const MutationPointAddress &getAddress() const;
   llvm::Value *getOriginalValue() const;
   MullModule *getOriginalModule() const;
-  const SourceLocation &getSourceLocation() const;
+  SourceLocation getSourceLocation() const;
 
-  void addReachableTest(Test *test, int distance);
+  /// The row is usually shared by all the mutation points of a function
+  void setReachableTests(std::shared_ptr<const ReachableTests> tests);
   void applyMutation(MullModule &module);
 
-  const std::vector<std::pair<Test *, int>> &getReachableTests() const;
+  const ReachableTests &getReachableTests() const;
+
+  /// Calls of the mutated function summed over the reachable tests, i.e. how
+  /// many times the mutant is executed. Zero unless the calls are counted,
+  /// see 'call_counts' option.
+  uint64_t getCallCount() const;
 
   std::string getUniqueIdentifier();
   std::string getUniqueIdentifier() const;
 
-  const std::string &getDiagnostics();
-  const std::string &getDiagnostics() const;
+  /// Rendered by the mutator on each call, see Mutator::describe
+  std::string getDiagnostics() const;
 };
 
 }
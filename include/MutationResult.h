@@ -22,6 +22,7 @@ public:
   ExecutionResult &getExecutionResult() { return Result; }
   MutationPoint *getMutationPoint()     { return MutPoint; }
   int getMutationDistance()             { return distance; }
+  /// Null for the mutants that are not covered by any test
   Test *getTest()                       { return test; }
 };
 
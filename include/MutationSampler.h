@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/ADT/DenseMap.h>
+
+namespace mull {
+
+class MutationPoint;
+class MutationResult;
+
+/// The mutants of one mutator in one module
+struct SamplingStratum {
+  std::string mutator;
+  std::string module;
+  /// Number of mutants in the stratum
+  size_t population;
+  /// Number of mutants drawn from the stratum
+  size_t sampleSize;
+  /// Number of the drawn mutants that have been run, and killed
+  size_t executed;
+  size_t killed;
+
+  SamplingStratum(const std::string &mutator, const std::string &module)
+      : mutator(mutator), module(module), population(0), sampleSize(0),
+        executed(0), killed(0) {}
+};
+
+/// The mutation score of all the mutants, estimated from the mutants run so
+/// far, with its confidence interval
+struct MutationScoreEstimate {
+  double score;
+  double lower;
+  double upper;
+  size_t executed;
+
+  double width() const { return upper - lower; }
+};
+
+/// Runs a random sample of the mutants instead of all of them, see
+/// 'sampling' option.
+///
+/// The mutants are split into strata by mutator and module. Each stratum gets
+/// at least one mutant, if the sample is large enough, and the rest of the
+/// sample is split proportionally to the size of the strata. Within a stratum
+/// the mutants are drawn by a seeded shuffle, so the same seed and the same
+/// mutants give the same sample.
+///
+/// The sample is ordered so that any prefix of it is spread over the strata
+/// like the whole sample: the mutants can be run in chunks, and the run can
+/// stop as soon as the confidence interval is narrow enough.
+///
+/// The score is the stratified estimate: the score of each stratum weighted
+/// by the size of the stratum. The interval is the Wilson score interval
+/// for the effective sample size of the stratified estimate.
+class MutationSampler {
+public:
+  /// Two-sided 95% confidence
+  static constexpr double ConfidenceZ = 1.96;
+
+  MutationSampler(uint32_t seed, size_t sampleSize);
+
+  /// Draws the sample from the points and returns it in the order to run it
+  std::vector<MutationPoint *> sample(const std::vector<MutationPoint *> &points);
+
+  /// Accounts for the results of the run mutants. All the results of a
+  /// mutant must be passed at once.
+  void record(const std::vector<std::unique_ptr<MutationResult>> &results);
+
+  MutationScoreEstimate estimate() const;
+
+  uint32_t getSeed() const;
+  size_t getPopulation() const;
+  const std::vector<SamplingStratum> &getStrata() const;
+
+  /// Number of mutants to draw from each stratum, see above
+  static std::vector<size_t> allocate(const std::vector<size_t> &populations,
+                                      size_t sampleSize);
+  static MutationScoreEstimate estimate(const std::vector<SamplingStratum> &strata);
+
+private:
+  uint32_t seed;
+  size_t sampleSize;
+  size_t population;
+  std::vector<SamplingStratum> strata;
+  llvm::DenseMap<MutationPoint *, size_t> stratumIndices;
+};
+
+}
@@ -23,9 +23,14 @@ public:
   std::vector<MutationPoint *> getMutationPoints(const Context &context,
                                                  std::vector<MergedTestee> &testees,
                                                  Filter &filter);
+  /// Frees the points found by the last call of getMutationPoints that are
+  /// not in 'kept', e.g. the junk ones
+  void discardMutationPoints(const std::vector<MutationPoint *> &kept);
 private:
   std::vector<std::unique_ptr<Mutator>> mutators;
   std::vector<std::unique_ptr<MutationPoint>> ownedPoints;
+  /// Where the points of the last call of getMutationPoints start
+  size_t lastPointsBegin;
   Config &config;
 };
 }
@@ -34,9 +34,11 @@ public:
                                     llvm::Instruction *instruction,
                                     SourceLocation &sourceLocation) override;
 
+  std::vector<unsigned> getOpcodes() const override;
+  std::string describe(const MutationPoint &point) const override;
   bool canBeApplied(llvm::Value &V) override;
   llvm::Value *
-  applyMutation(llvm::Module *module, MutationPointAddress &address) override;
+  applyMutation(MullModule *module, MutationPointAddress &address) override;
 };
 
 }
@@ -37,9 +37,21 @@ public:
   virtual std::string getUniqueIdentifier() const = 0;
   virtual MutatorKind mutatorKind()  { return MutatorKind::Unknown; }
 
+  /// Opcodes of the instructions the mutator may find mutation points in,
+  /// empty when it may find them in any instruction.
+  /// Only these instructions are passed to 'getMutationPoint'.
+  virtual std::vector<unsigned> getOpcodes() const {
+    return std::vector<unsigned>();
+  }
+
+  /// Human-readable description of the mutation, e.g. for IDE diagnostics.
+  /// Rendered from the original instruction of the point on each call,
+  /// the points do not store it.
+  virtual std::string describe(const MutationPoint &point) const = 0;
+
   virtual bool canBeApplied(llvm::Value &V) = 0;
   virtual llvm::Value *
-  applyMutation(llvm::Module *module, MutationPointAddress &address) = 0;
+  applyMutation(MullModule *module, MutationPointAddress &address) = 0;
   virtual ~Mutator() = default;
 };
 
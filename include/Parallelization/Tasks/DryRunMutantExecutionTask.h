@@ -13,6 +13,12 @@ public:
   using Out = std::vector<std::unique_ptr<MutationResult>>;
   using iterator = In::const_iterator;
 
+  /// See MutantCostModel about 'failFast'
+  explicit DryRunMutantExecutionTask(bool failFast);
+
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
+
+private:
+  bool failFast;
 };
 }
@@ -7,6 +7,7 @@
 
 namespace mull {
 
+class Config;
 class Toolchain;
 class Instrumentation;
 class progress_counter;
@@ -17,11 +18,12 @@ public:
   using Out = std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>>;
   using iterator = In::const_iterator;
 
-  InstrumentedCompilationTask(Instrumentation &instrumentation, Toolchain &toolchain);
+  InstrumentedCompilationTask(Instrumentation &instrumentation, Toolchain &toolchain, Config &config);
 
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
 private:
   Instrumentation &instrumentation;
   Toolchain &toolchain;
+  Config &config;
 };
 }
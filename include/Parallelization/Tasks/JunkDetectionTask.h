@@ -7,15 +7,21 @@ class MutationPoint;
 class progress_counter;
 class JunkDetector;
 
+/// Checks the mutation points of whole translation units, so that each
+/// worker parses its own units, see CXXJunkDetector.
 class JunkDetectionTask {
 public:
-  using In = std::vector<MutationPoint *>;
+  using In = std::vector<std::vector<MutationPoint *>>;
   using Out = std::vector<MutationPoint *>;
   using iterator = In::const_iterator;
 
   JunkDetectionTask(JunkDetector &detector);
 
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
+
+  /// Groups the points by the source file of their module, in the order the
+  /// source files first appear
+  static In groupByTranslationUnit(const std::vector<MutationPoint *> &points);
 private:
   JunkDetector &detector;
 };
@@ -1,18 +1,20 @@
 #pragma once
 
+#include "ForkProcessSandbox.h"
 #include "MutationResult.h"
+#include "TestRunner.h"
 #include "Toolchain/JITEngine.h"
 
 namespace mull {
 
 class MutationPoint;
+class Test;
 class Driver;
-class ProcessSandbox;
-class TestRunner;
 class Config;
 class Toolchain;
 class Filter;
 class progress_counter;
+class Zygote;
 
 class MutantExecutionTask {
 public:
@@ -25,15 +27,30 @@ public:
                       TestRunner &runner,
                       Config &config,
                       Toolchain &toolchain,
-                      Filter &filter);
+                      Filter &filter,
+                      Zygote *zygote);
 
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
+
+  /// Runs each reachable test in a separate sandbox. 'zygoteProgram' is set
+  /// when the zygote has loaded the program and runs the tests instead.
+  void runTests(MutationPoint *mutationPoint, Out &storage,
+                TestRunner::ObjectFiles *zygoteProgram = nullptr);
+  /// Runs all the reachable tests in one sandbox, see 'batch_tests' option
+  void runTestsInBatch(MutationPoint *mutationPoint, Out &storage);
+  /// The execution budget of a test, zero if the budget is disabled
+  uint64_t executionBudget(Test *test);
+
   JITEngine jit;
+  InProcessSandbox inProcessSandbox;
   ProcessSandbox &sandbox;
   TestRunner &runner;
   Config &config;
   Toolchain &toolchain;
   Filter &filter;
   Driver &driver;
+  /// Runs the tests instead of the sandbox when the 'zygote' option is
+  /// enabled, as long as it keeps running
+  Zygote *zygote;
 };
 }
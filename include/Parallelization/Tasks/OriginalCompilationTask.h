@@ -6,6 +6,7 @@
 #include <llvm/Object/ObjectFile.h>
 
 namespace mull {
+class Config;
 class Toolchain;
 class progress_counter;
 
@@ -15,9 +16,10 @@ public:
   using Out = std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>>;
   using iterator = In::const_iterator;
 
-  explicit OriginalCompilationTask(Toolchain &toolchain);
+  OriginalCompilationTask(Toolchain &toolchain, Config &config);
 
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
   Toolchain &toolchain;
+  Config &config;
 };
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Instrumentation/DynamicCallTree.h"
+#include "Instrumentation/InstrumentationBuffers.h"
+#include "Instrumentation/SamplingProfiler.h"
 #include "Test.h"
 #include "Testee.h"
 
@@ -12,6 +15,7 @@ class Config;
 class Filter;
 class JITEngine;
 class progress_counter;
+class ReachabilityCache;
 
 class OriginalTestExecutionTask {
 public:
@@ -24,7 +28,9 @@ public:
                             TestRunner &runner,
                             Config &config,
                             Filter &filter,
-                            JITEngine &jit);
+                            JITEngine &jit,
+                            ReachabilityCache *cache,
+                            const SamplingProfiler *profiler);
 
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
   Instrumentation &instrumentation;
@@ -33,5 +39,14 @@ public:
   Config &config;
   Filter &filter;
   JITEngine &jit;
+  /// Optional, see 'use_cache'
+  ReachabilityCache *cache;
+  /// Optional, the tests are run uninstrumented when set,
+  /// see 'reachability: sampling'
+  const SamplingProfiler *profiler;
+  std::shared_ptr<SamplingStatistics> samplingStatistics;
+  /// Created on the first test that is not cached
+  std::shared_ptr<InstrumentationBuffers> buffers;
+  CallForest callForest;
 };
 }
@@ -16,11 +16,25 @@ public:
   using Out = std::vector<std::unique_ptr<MutationPoint>>;
   using iterator = In::const_iterator;
 
-  SearchMutationPointsTask(Filter &filter, const Context &context, std::vector<std::unique_ptr<Mutator>> &mutators);
+  /// With 'blockCoverage' a mutation point gets only the tests that
+  /// executed its basic block.
+  ///
+  /// The instructions of a testee are walked once for all the mutators:
+  /// each instruction is passed only to the mutators handling its opcode,
+  /// see Mutator::getOpcodes.
+  SearchMutationPointsTask(Filter &filter, const Context &context,
+                           std::vector<std::unique_ptr<Mutator>> &mutators,
+                           bool blockCoverage = false);
   void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
 private:
   Filter &filter;
   const Context &context;
   std::vector<std::unique_ptr<Mutator>> &mutators;
+  bool blockCoverage;
+
+  /// Indices of the mutators, by opcode
+  std::vector<std::vector<size_t>> mutatorsByOpcode;
+  /// Indices of the mutators that handle any opcode
+  std::vector<size_t> anyOpcodeMutators;
 };
 }
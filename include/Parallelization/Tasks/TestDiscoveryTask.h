@@ -0,0 +1,25 @@
+#pragma once
+
+#include "MullModule.h"
+#include "TestFinder.h"
+
+namespace mull {
+
+class TestDiscoveryCache;
+class progress_counter;
+
+class TestDiscoveryTask {
+public:
+  using In = const std::vector<std::unique_ptr<MullModule>>;
+  using Out = std::vector<DiscoveredModuleTests>;
+  using iterator = In::const_iterator;
+
+  /// The 'cache' may be null
+  TestDiscoveryTask(ModuleTestFinder &finder, const TestDiscoveryCache *cache);
+  void operator() (iterator begin, iterator end, Out &storage, progress_counter &counter);
+private:
+  ModuleTestFinder &finder;
+  const TestDiscoveryCache *cache;
+};
+
+}
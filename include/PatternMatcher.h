@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/ADT/StringRef.h>
+
+namespace llvm {
+class Regex;
+}
+
+namespace mull {
+
+/// Tells whether a text contains any of a set of patterns.
+///
+/// A pattern is a plain substring, or a regular expression when it starts
+/// with 'regex:', e.g. 'regex:^/usr/(local/)?include/'.
+/// The substrings are compiled into a single Aho-Corasick automaton, so that
+/// a text is scanned once no matter how many substrings there are.
+class PatternMatcher {
+public:
+  static const char *const RegexPrefix;
+
+  PatternMatcher();
+  ~PatternMatcher();
+
+  PatternMatcher(const PatternMatcher &) = delete;
+  PatternMatcher &operator=(const PatternMatcher &) = delete;
+
+  /// Invalid regular expressions are reported and ignored
+  void addPattern(const std::string &pattern);
+
+  bool empty() const;
+  bool matches(llvm::StringRef text) const;
+
+private:
+  struct Node {
+    /// Sorted by the character
+    std::vector<std::pair<char, int>> children;
+    int failure;
+    bool terminal;
+  };
+
+  int child(int node, char character) const;
+  void computeFailureLinks();
+
+  std::vector<Node> nodes;
+  std::vector<std::unique_ptr<llvm::Regex>> regexes;
+};
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ExecutionResult.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+class BasicBlock;
+class Function;
+}
+
+namespace mull {
+
+class Config;
+class Context;
+class Test;
+class Testee;
+
+/// Results of the original test runs, persisted between Mull runs: the
+/// execution result of each test, the functions it reaches with their
+/// distances and, with 'block_coverage' and 'call_counts', the blocks it
+/// executes and the number of calls of each function.
+///
+/// All the entries of a program live in one file in the cache directory.
+/// The file is named after a hash of all the modules and of the options the
+/// call trees depend on, so any change in the code or in those options
+/// starts a new file. Within the file the entries are keyed by the unique
+/// identifier of a test.
+///
+/// The functions and blocks are stored by module identifier, function name
+/// and block index. Entries referring to something that cannot be found in
+/// the loaded modules are dropped when the file is read.
+class ReachabilityCache {
+public:
+  ReachabilityCache(Config &config, Context &context);
+
+  /// True when every test has an entry, hence the instrumented program
+  /// does not need to be compiled and run at all
+  bool containsAll(const std::vector<std::unique_ptr<Test>> &tests) const;
+
+  /// Restores the execution result, the covered blocks and the call counts
+  /// of the test and appends its testees. Returns false if the test is not cached.
+  /// Safe to call from several threads
+  bool restore(Test *test, std::vector<std::unique_ptr<Testee>> &testees) const;
+  /// Safe to call from several threads
+  void store(Test *test, const std::vector<std::unique_ptr<Testee>> &testees);
+
+  /// Writes the file if anything was stored
+  void save();
+
+private:
+  struct Entry {
+    ExecutionResult result;
+    std::vector<std::pair<llvm::Function *, int>> functions;
+    std::vector<llvm::BasicBlock *> blocks;
+    std::vector<std::pair<llvm::Function *, uint64_t>> callCounts;
+  };
+
+  void read();
+  std::string functionKey(llvm::Function *function) const;
+
+  std::string path;
+  std::map<std::string, Entry> entries;
+  bool modified;
+  mutable std::mutex mutex;
+
+  std::unordered_map<std::string, llvm::Function *> functionsByKey;
+  /// Index of a block within its function, filled in with 'block_coverage'
+  std::unordered_map<llvm::BasicBlock *, uint32_t> blockIndices;
+};
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mull {
+
+class Test;
+
+/// Tests reaching a function, one row of the function-by-test reachability
+/// matrix built by 'mergeTestees'.
+///
+/// All the rows of a matrix share the list of tests, a row itself is a bit
+/// per test plus the distances of the reaching tests, stored in the order of
+/// the tests. Mutation points share the row of their function instead of
+/// copying it.
+class ReachableTests {
+public:
+  /// Iterates over the reaching tests as (test, distance) pairs
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<Test *, int>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    iterator(const ReachableTests &row, size_t testIndex, size_t rank);
+
+    reference operator*() const { return current; }
+    pointer operator->() const { return &current; }
+    iterator &operator++();
+    bool operator==(const iterator &other) const {
+      return testIndex == other.testIndex;
+    }
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  private:
+    void load();
+
+    const ReachableTests *row;
+    size_t testIndex;
+    size_t rank;
+    value_type current;
+  };
+
+  ReachableTests();
+  explicit ReachableTests(std::shared_ptr<const std::vector<Test *>> tests);
+
+  /// Marks the test at 'testIndex' of the shared list of tests as reaching
+  /// the function. A test reaching it several times keeps the shortest
+  /// distance.
+  void add(size_t testIndex, int distance);
+
+  /// A copy of the row with only the tests accepted by the predicate
+  std::shared_ptr<ReachableTests>
+  filter(const std::function<bool(Test *)> &predicate) const;
+
+  bool empty() const;
+  size_t size() const;
+
+  iterator begin() const;
+  iterator end() const;
+
+private:
+  static const size_t BitsPerWord = 64;
+
+  bool contains(size_t testIndex) const;
+  /// Number of set bits before 'testIndex', i.e. the index of its distance
+  size_t rank(size_t testIndex) const;
+  size_t nextTest(size_t testIndex) const;
+
+  std::shared_ptr<const std::vector<Test *>> tests;
+  std::vector<uint64_t> bits;
+  std::vector<uint16_t> distances;
+  size_t lastTest;
+};
+
+}
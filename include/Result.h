@@ -3,6 +3,7 @@
 #include "Test.h"
 #include "MutationResult.h"
 #include "MutationPoint.h"
+#include "MutationSampler.h"
 #include <vector>
 
 namespace mull {
@@ -11,6 +12,7 @@ namespace mull {
     std::vector<std::unique_ptr<Test>> tests;
     std::vector<std::unique_ptr<MutationResult>> mutationResults;
     std::vector<MutationPoint *> mutationPoints;
+    std::unique_ptr<MutationSampler> sampler;
 
   public:
     Result(std::vector<std::unique_ptr<Test>> tests,
@@ -18,7 +20,8 @@ namespace mull {
            std::vector<MutationPoint *> mutationPoints)
     : tests(std::move(tests)),
       mutationResults(std::move(mutationResults)),
-      mutationPoints(std::move(mutationPoints))
+      mutationPoints(std::move(mutationPoints)),
+      sampler()
     {}
 
     std::vector<std::unique_ptr<Test>> const& getTests() const {
@@ -32,5 +35,14 @@ namespace mull {
     std::vector<MutationPoint *> const& getMutationPoints() const {
       return mutationPoints;
     }
+
+    /// Null unless the mutants were sampled, see 'sampling' option
+    const MutationSampler *getSampler() const {
+      return sampler.get();
+    }
+
+    void setSampler(std::unique_ptr<MutationSampler> mutationSampler) {
+      sampler = std::move(mutationSampler);
+    }
   };
 }
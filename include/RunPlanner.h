@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace mull {
+
+class MutantCostModel;
+class MutationPoint;
+
+/// Chooses the mutants to run within 'time_budget'.
+///
+/// The mutants are split by mutator and module, like MutationSampler does.
+/// The plan takes the cheapest mutant of each of them, then the second
+/// cheapest one, and so on: as many mutators and modules as possible are
+/// covered before the budget runs out.
+///
+/// The mutants are handed out in chunks that fit into the time left, the
+/// predicted costs being spread over the workers. The time each chunk has
+/// actually taken corrects the predictions for the next chunks, hence a chunk
+/// takes only a fraction of the time left: the predictions are corrected
+/// while there is still time to act on them.
+class RunPlanner {
+public:
+  RunPlanner(const std::vector<MutationPoint *> &points,
+             MutantCostModel &costModel, int workers);
+
+  /// The next mutants of the plan, at most 'chunkSize' of them, that are
+  /// predicted to finish within a quarter of 'remainingTime' milliseconds of
+  /// wall time. A single mutant may take up to the whole 'remainingTime'.
+  /// Empty when nothing fits anymore.
+  std::vector<MutationPoint *> nextChunk(double remainingTime, size_t chunkSize);
+
+  /// Corrects the predictions by the wall time the last chunk has taken
+  void calibrate(double elapsedTime);
+
+  /// The mutants that have not been handed out, in the order of the plan
+  std::vector<MutationPoint *> remaining() const;
+
+  /// Actual time per predicted time, one until a chunk has been run
+  double getCalibration() const;
+
+private:
+  struct PlannedMutant {
+    MutationPoint *point;
+    double cost;
+    size_t stratum;
+    size_t rank;
+  };
+
+  std::vector<PlannedMutant> plan;
+  std::vector<bool> handedOut;
+  int workers;
+  /// Predicted cost of the last chunk, and of all the run chunks
+  double chunkCost;
+  double predictedCost;
+  double elapsedTime;
+};
+
+}
@@ -10,11 +10,17 @@ namespace mull {
 class Context;
 class Filter;
 
-class SimpleTestFinder : public TestFinder {
+class SimpleTestFinder : public ModuleTestFinder {
 public:
+  SimpleTestFinder(int workers = 1, const std::string &cacheDirectory = "");
+
   // Finds all methods that start with "test_"
-  std::vector<std::unique_ptr<Test>> findTests(Context &context,
-                                               Filter &filter) override;
+  std::vector<DiscoveredTest> discoverTests(llvm::Module *module) override;
+  std::string discoveryKey() const override;
+  std::unique_ptr<Test> createTest(const DiscoveredTest &test,
+                                   llvm::Function *entryPoint,
+                                   const std::vector<llvm::Function *> &constructors,
+                                   Filter &filter) override;
 };
 
 }
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Testee.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace llvm {
+class Function;
+class FunctionType;
+}
+
+namespace mull {
+
+class Context;
+class Filter;
+class Test;
+
+/// Call graph of all the functions defined in the loaded modules, built
+/// without running anything, see 'reachability' option.
+///
+/// Direct calls to functions declared in one module and defined in another
+/// are resolved by name. Indirect calls, including virtual calls, are
+/// assumed to reach every function whose address is taken and whose
+/// signature matches the one of the call. Pointer types are not compared
+/// for that matter: 'this' of a virtual call is a pointer to the base class.
+///
+/// Code outside of the loaded modules may call back functions whose address
+/// is passed to it: a thread entry point or a 'qsort' callback. These
+/// functions are roots: every test is assumed to reach them at the distance
+/// of one call. The methods in vtables are not roots, otherwise every test
+/// would reach every 'TestBody' and every virtual method.
+class StaticCallGraph {
+public:
+  explicit StaticCallGraph(Context &context);
+
+  /// Functions reachable from the entry points of the test with the shortest
+  /// distance to them, the same way the dynamic call tree reports them.
+  /// The entry points themselves are not included.
+  std::vector<std::unique_ptr<Testee>> getTestees(Test *test, Filter &filter,
+                                                  int maxDistance);
+
+  /// All the functions reachable from the entry points of the tests,
+  /// entry points included
+  std::unordered_set<llvm::Function *>
+  reachableFunctions(const std::vector<std::unique_ptr<Test>> &tests);
+
+  const std::vector<llvm::Function *> &getCallees(llvm::Function *function);
+
+private:
+  void addCalls(llvm::Function &function);
+  bool addressEscapes(llvm::Value *address);
+  llvm::Function *definitionOf(llvm::Function *function);
+
+  Context &context;
+  std::unordered_map<llvm::Function *, std::vector<llvm::Function *>> callees;
+  /// Address-taken functions by signature, the targets of indirect calls
+  std::map<std::string, std::vector<llvm::Function *>> indirectTargets;
+  /// Address-taken functions passed to the code outside of the loaded modules
+  std::vector<llvm::Function *> roots;
+};
+
+}
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ExecutionResult.h"
 #include "Instrumentation/InstrumentationInfo.h"
 
 namespace llvm {
+class BasicBlock;
 class Function;
 }
 
@@ -23,6 +27,36 @@ public:
   ExecutionResult &getExecutionResult() { return executionResult; }
   InstrumentationInfo &getInstrumentationInfo() { return instrumentationInfo; }
 
+  /// Basic blocks executed by the test, see 'block_coverage' option.
+  /// The blocks must be sorted.
+  void setCoveredBlocks(std::vector<llvm::BasicBlock *> blocks) {
+    coveredBlocks = std::move(blocks);
+  }
+  const std::vector<llvm::BasicBlock *> &getCoveredBlocks() const {
+    return coveredBlocks;
+  }
+  bool coversBlock(llvm::BasicBlock *block) const {
+    return std::binary_search(coveredBlocks.begin(), coveredBlocks.end(), block);
+  }
+
+  /// Number of calls of each function reached by the test, see 'call_counts'
+  /// option. The counts must be sorted by function.
+  void setCallCounts(std::vector<std::pair<llvm::Function *, uint64_t>> counts) {
+    callCounts = std::move(counts);
+  }
+  const std::vector<std::pair<llvm::Function *, uint64_t>> &getCallCounts() const {
+    return callCounts;
+  }
+  /// Zero when the function is not reached or the calls are not counted
+  uint64_t getCallCount(llvm::Function *function) const {
+    auto count = std::lower_bound(callCounts.begin(), callCounts.end(),
+                                  std::make_pair(function, uint64_t(0)));
+    if (count == callCounts.end() || count->first != function) {
+      return 0;
+    }
+    return count->second;
+  }
+
   /// Entry points into the test might be the test body, setup/teardown,
   /// before each/before all functions, and so on.
   /// TODO: entryPoints is not the best name for teardown/after each methods
@@ -43,6 +77,8 @@ public:
 private:
   ExecutionResult executionResult;
   InstrumentationInfo instrumentationInfo;
+  std::vector<llvm::BasicBlock *> coveredBlocks;
+  std::vector<std::pair<llvm::Function *, uint64_t>> callCounts;
 
   const TestKind Kind;
 };
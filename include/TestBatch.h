@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ExecutionResult.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mull {
+
+class Test;
+
+/// Outcome of a single test of a batch.
+/// Stored in shared memory, hence it must stay a plain struct.
+struct TestBatchEntry {
+  ExecutionStatus status;
+  long long runningTime;
+};
+
+/// A list of tests executed one after another within one sandboxed process.
+///
+/// The state of the batch lives in memory shared between the parent and the
+/// child: before running a test the child stores its index as the 'current'
+/// one, after the test is finished the child stores its status and running
+/// time. When the child crashes or times out the parent knows which test
+/// caused it and can restart the batch right after that test.
+class TestBatch {
+public:
+  TestBatch(std::vector<Test *> tests, bool stopAfterFailure);
+  ~TestBatch();
+
+  TestBatch(const TestBatch &) = delete;
+  TestBatch &operator=(const TestBatch &) = delete;
+
+  /// False when the shared memory could not be allocated: the batch cannot
+  /// be run then
+  bool isValid() const;
+
+  size_t size() const;
+  Test *getTest(size_t index) const;
+
+  /// Index of the first test to run. Tests before it are already processed.
+  size_t getFirst() const;
+  /// Resets the shared state so that the next run starts from 'first'.
+  void restartFrom(size_t first);
+
+  /// Index of the test being run. Equals to 'size()' when the batch finished.
+  size_t getCurrent() const;
+  void setCurrent(size_t index);
+
+  TestBatchEntry &getEntry(size_t index);
+  void setEntry(size_t index, ExecutionStatus status, long long runningTime);
+
+  /// Tells the process running the batch to stop after the first failed test
+  bool shouldStopAfterFailure() const;
+
+  /// See ExecutionBudget. Zero means no limit.
+  uint64_t getExecutionBudget(size_t index) const;
+  void setExecutionBudget(size_t index, uint64_t budget);
+
+  /// Timeout of a single test, the process running the batch restarts its
+  /// timeout with it before the test. Zero means the process keeps the
+  /// timeout it was started with.
+  long long getTimeout(size_t index) const;
+  void setTimeout(size_t index, long long timeout);
+
+private:
+  struct SharedState {
+    size_t current;
+    TestBatchEntry entries[1];
+  };
+
+  std::vector<Test *> tests;
+  std::vector<uint64_t> executionBudgets;
+  std::vector<long long> timeouts;
+  bool stopAfterFailure;
+  size_t first;
+  size_t sharedSize;
+  SharedState *shared;
+};
+
+}
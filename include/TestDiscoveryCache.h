@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+namespace mull {
+
+class MullModule;
+struct DiscoveredModuleTests;
+
+/// Tests found in a module by a ModuleTestFinder, persisted between Mull
+/// runs, see 'caching'.
+///
+/// Each module has its own file in the cache directory, named after a hash
+/// of the unique identifier of the module (which contains the MD5 of its
+/// bitcode) and of the discovery key of the finder. A changed module, or a
+/// changed test definition, hence starts a new file. Modules are read and
+/// written independently, so the cache can be used from several threads.
+class TestDiscoveryCache {
+public:
+  TestDiscoveryCache(const std::string &directory, const std::string &key);
+
+  /// Fills in the tests and the constructors of 'tests.module'.
+  /// Returns false if the module is not cached.
+  bool restore(DiscoveredModuleTests &tests) const;
+  void store(const DiscoveredModuleTests &tests) const;
+
+private:
+  std::string pathForModule(MullModule *module) const;
+
+  std::string directory;
+  std::string key;
+};
+
+}
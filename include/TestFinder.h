@@ -3,11 +3,19 @@
 #include "Test.h"
 
 #include <memory>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class Function;
+class Module;
+}
 
 namespace mull {
 
 class Context;
 class Filter;
+class MullModule;
 
 class TestFinder {
 public:
@@ -16,4 +24,58 @@ public:
   virtual ~TestFinder() {}
 };
 
+/// A test found in a module. The functions are referred to by name, so
+/// that the test can be cached, see TestDiscoveryCache.
+struct DiscoveredTest {
+  std::string name;
+  std::string entryPoint;
+
+  DiscoveredTest(const std::string &name, const std::string &entryPoint)
+      : name(name), entryPoint(entryPoint) {}
+};
+
+/// Everything a ModuleTestFinder finds in one module
+struct DiscoveredModuleTests {
+  MullModule *module;
+  std::vector<DiscoveredTest> tests;
+  /// Names of the static constructors of the module
+  std::vector<std::string> constructors;
+
+  DiscoveredModuleTests() : module(nullptr), tests(), constructors() {}
+};
+
+/// A test finder that finds the tests of each module on its own.
+///
+/// The modules are searched in parallel by TestDiscoveryTask. With a cache
+/// directory, the tests of a module are stored under the MD5 of the module
+/// and are not searched for again until the module changes. The Test objects
+/// are then created from the discovered tests on the calling thread, in the
+/// order of the modules.
+class ModuleTestFinder : public TestFinder {
+public:
+  /// An empty 'cacheDirectory' disables the caching
+  ModuleTestFinder(int workers, const std::string &cacheDirectory);
+
+  std::vector<std::unique_ptr<Test>> findTests(Context &context,
+                                               Filter &filter) override;
+
+  /// Finds the tests in the module. Called from several threads at once.
+  virtual std::vector<DiscoveredTest> discoverTests(llvm::Module *module) = 0;
+
+  /// Everything the discovered tests depend on besides the module itself,
+  /// e.g. the test definitions. The cached tests are keyed by it as well.
+  virtual std::string discoveryKey() const = 0;
+
+  /// Creates the test, nullptr if the test is filtered out.
+  /// 'constructors' are the static constructors of all the modules.
+  virtual std::unique_ptr<Test>
+  createTest(const DiscoveredTest &test, llvm::Function *entryPoint,
+             const std::vector<llvm::Function *> &constructors,
+             Filter &filter) = 0;
+
+private:
+  int workers;
+  std::string cacheDirectory;
+};
+
 }
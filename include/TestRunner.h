@@ -10,6 +10,7 @@ namespace mull {
 
 class JITEngine;
 class Test;
+class TestBatch;
 class Instrumentation;
 
 class TestRunner {
@@ -25,6 +26,14 @@ public:
   virtual void loadProgram(ObjectFiles &objectFiles, JITEngine &jit) = 0;
   virtual ExecutionStatus runTest(Test *test, JITEngine &jit) = 0;
 
+  /// Runners that can execute several tests within one process override
+  /// this to return true and implement 'runTests'
+  virtual bool supportsBatchExecution() const;
+
+  /// Runs the tests of the batch starting from 'batch.getFirst()' one after
+  /// another and records the outcome of each test in the batch
+  virtual void runTests(TestBatch &batch, JITEngine &jit);
+
   virtual ~TestRunner() = default;
 };
 
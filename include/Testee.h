@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ReachableTests.h"
+
 #include <llvm/IR/Function.h>
 
 namespace mull {
@@ -7,12 +9,14 @@ class Test;
 
 class MergedTestee {
 public:
-  explicit MergedTestee(llvm::Function *function, Test *test, int distance);
-  void addReachableTest(Test *test, int distance);
-  const std::vector<std::pair<Test *, int>> &getReachableTests() const;
+  MergedTestee(llvm::Function *function,
+               std::shared_ptr<ReachableTests> reachableTests);
+  const ReachableTests &getReachableTests() const;
+  /// The same row as above, to be shared with the mutation points
+  std::shared_ptr<const ReachableTests> shareReachableTests() const;
   llvm::Function *getTesteeFunction() const;
 private:
-  std::vector<std::pair<Test *, int>> reachableTests;
+  std::shared_ptr<ReachableTests> reachableTests;
   llvm::Function *function;
 };
 
@@ -28,6 +32,8 @@ private:
   int distance;
 };
 
+/// Builds the function-by-test reachability matrix, one MergedTestee per
+/// function, in the order the functions first appear in 'testees'
 std::vector<MergedTestee> mergeTestees(std::vector<std::unique_ptr<Testee>> &testees);
 
 }
@@ -15,6 +15,7 @@ public:
                       llvm_compat::SymbolResolver  &resolver,
                       std::unique_ptr<llvm::RuntimeDyld::MemoryManager> memoryManager);
   llvm_compat::JITSymbol &getSymbol(llvm::StringRef name);
+  const std::vector<llvm::object::ObjectFile *> &getObjectFiles() const;
 };
 
 }
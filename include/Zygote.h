@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ExecutionResult.h"
+
+#include <llvm/Object/ObjectFile.h>
+
+#include <cstdint>
+#include <map>
+#include <sys/types.h>
+#include <vector>
+
+namespace mull {
+
+class Test;
+class TestRunner;
+
+/// A process forked from Mull right after the tests are found, before any
+/// code is compiled and loaded, that runs tests against mutants on Mull's
+/// behalf. It inherits the bitcode modules Mull has loaded by then: the tests
+/// point into them.
+///
+/// Mull talks to the zygote over a socket pair:
+///
+///  - object files are sent once, as file descriptors, and are kept by the
+///    zygote until they are released
+///  - 'loadProgram' makes the zygote fork a host process that links the given
+///    object files once and then serves 'runTest' requests, each test is run
+///    in a ForkProcessSandbox forked from the small host process
+///  - 'unloadProgram' terminates the host
+///
+/// Tests and test runners are passed as plain pointers: the zygote is a copy
+/// of the Mull process, hence they stay valid as long as the tests are found
+/// before the zygote is started.
+///
+/// When the zygote cannot be started, or stops answering, it is shut down
+/// for good: 'loadProgram' and 'runTest' fail from then on, and the caller
+/// runs the tests on its own, e.g. in a ForkProcessSandbox.
+class Zygote {
+public:
+  /// Forks the zygote. The calling process must have only one thread.
+  explicit Zygote(TestRunner &runner);
+  ~Zygote();
+
+  Zygote(const Zygote &) = delete;
+  Zygote &operator=(const Zygote &) = delete;
+
+  bool isRunning() const;
+
+  /// Sends the object files the zygote has not seen yet and starts a host
+  /// process that links all of them. False if the zygote is not running.
+  bool loadProgram(const std::vector<llvm::object::ObjectFile *> &objectFiles);
+  /// False if the zygote is not running, the result is not set then
+  bool runTest(Test *test, long long timeoutMilliseconds,
+               uint64_t executionBudget, ExecutionResult &result);
+  void unloadProgram();
+
+  /// Tells the zygote to drop the object file, e.g. a compiled mutant which
+  /// is not needed after its tests are run
+  void releaseObjectFile(llvm::object::ObjectFile *objectFile);
+
+private:
+  bool sendObjectFile(llvm::object::ObjectFile *objectFile, uint64_t &id);
+  void failed(const char *action);
+  void shutDown();
+
+  int socket;
+  pid_t pid;
+  uint64_t nextObjectFileId;
+  std::map<llvm::object::ObjectFile *, uint64_t> objectFileIds;
+};
+
+}
@@ -45,6 +45,35 @@ bool JunkDetectionConfig::isEnabled() const {
   return toggle == JunkDetectionToggle::Enabled;
 }
 
+InProcessSandboxConfig::InProcessSandboxConfig() : testFrameworks(), tests() {}
+
+bool InProcessSandboxConfig::isEnabled() const {
+  return !testFrameworks.empty() || !tests.empty();
+}
+
+SamplingConfig::SamplingConfig() : size(0), seed(0), intervalWidth(0) {}
+
+bool SamplingConfig::isEnabled() const {
+  return size > 0;
+}
+
+bool InProcessSandboxConfig::isEnabledFor(const std::string &testFramework,
+                                          const std::string &testName) const {
+  for (auto &framework : testFrameworks) {
+    if (framework == testFramework) {
+      return true;
+    }
+  }
+
+  for (auto &test : tests) {
+    if (testName.find(test) != std::string::npos) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 std::string Config::forkToString(Fork fork) {
   switch (fork) {
     case Fork::Enabled:
@@ -82,6 +111,98 @@ std::string Config::failFastToString(FailFastMode failFast) {
   }
 }
 
+std::string Config::batchTestsToString(BatchTestsMode batchTests) {
+  switch (batchTests) {
+    case BatchTestsMode::Enabled:
+      return "enabled";
+      break;
+
+    case BatchTestsMode::Disabled:
+      return "disabled";
+      break;
+  }
+}
+
+std::string Config::instrumentationModeToString(InstrumentationMode mode) {
+  switch (mode) {
+    case InstrumentationMode::Callbacks:
+      return "callbacks";
+      break;
+
+    case InstrumentationMode::Inline:
+      return "inline";
+      break;
+  }
+}
+
+std::string Config::reachabilityModeToString(ReachabilityMode mode) {
+  switch (mode) {
+    case ReachabilityMode::Dynamic:
+      return "dynamic";
+      break;
+
+    case ReachabilityMode::Static:
+      return "static";
+      break;
+
+    case ReachabilityMode::Hybrid:
+      return "hybrid";
+      break;
+
+    case ReachabilityMode::Sampling:
+      return "sampling";
+      break;
+  }
+}
+
+std::string Config::blockCoverageToString(BlockCoverageMode blockCoverage) {
+  switch (blockCoverage) {
+    case BlockCoverageMode::Enabled:
+      return "enabled";
+      break;
+
+    case BlockCoverageMode::Disabled:
+      return "disabled";
+      break;
+  }
+}
+
+std::string Config::callCountsToString(CallCountsMode callCounts) {
+  switch (callCounts) {
+    case CallCountsMode::Enabled:
+      return "enabled";
+      break;
+
+    case CallCountsMode::Disabled:
+      return "disabled";
+      break;
+  }
+}
+
+std::string Config::streamingToString(StreamingMode streaming) {
+  switch (streaming) {
+    case StreamingMode::Enabled:
+      return "enabled";
+      break;
+
+    case StreamingMode::Disabled:
+      return "disabled";
+      break;
+  }
+}
+
+std::string Config::zygoteToString(ZygoteMode zygote) {
+  switch (zygote) {
+    case ZygoteMode::Enabled:
+      return "enabled";
+      break;
+
+    case ZygoteMode::Disabled:
+      return "disabled";
+      break;
+  }
+}
+
 std::string Config::cachingToString(UseCache caching) {
   switch (caching) {
     case UseCache::Yes:
@@ -145,14 +266,25 @@ Config::Config() :
   fork(Fork::Enabled),
   dryRun(DryRunMode::Disabled),
   failFast(FailFastMode::Disabled),
+  batchTests(BatchTestsMode::Disabled),
+  zygote(ZygoteMode::Disabled),
+  blockCoverage(BlockCoverageMode::Disabled),
+  callCounts(CallCountsMode::Disabled),
+  streaming(StreamingMode::Disabled),
+  instrumentationMode(InstrumentationMode::Callbacks),
+  reachabilityMode(ReachabilityMode::Dynamic),
   caching(UseCache::No),
   emitDebugInfo(EmitDebugInfo::No),
   diagnostics(Diagnostics::None),
   timeout(MullDefaultTimeoutMilliseconds),
   maxDistance(128),
+  executionBudget(0),
+  timeBudget(0),
   cacheDirectory("/tmp/mull_cache"),
   junkDetection(),
-  parallelizationConfig()
+  parallelizationConfig(),
+  inProcessSandbox(),
+  sampling()
 {}
 
 Config::Config(const std::string &bitcodeFileList,
@@ -189,14 +321,25 @@ customTests(definitions),
 fork(fork),
 dryRun(dryRun),
 failFast(failFast),
+batchTests(BatchTestsMode::Disabled),
+zygote(ZygoteMode::Disabled),
+blockCoverage(BlockCoverageMode::Disabled),
+callCounts(CallCountsMode::Disabled),
+streaming(StreamingMode::Disabled),
+instrumentationMode(InstrumentationMode::Callbacks),
+reachabilityMode(ReachabilityMode::Dynamic),
 caching(cache),
 emitDebugInfo(debugInfo),
 diagnostics(diagnostics),
 timeout(timeout),
 maxDistance(distance),
+executionBudget(0),
+timeBudget(0),
 cacheDirectory(cacheDir),
 junkDetection(std::move(junkDetection)),
-parallelizationConfig(parallelizationConfig)
+parallelizationConfig(parallelizationConfig),
+inProcessSandbox(),
+sampling()
 {
 }
 
@@ -312,6 +455,49 @@ bool Config::failFastModeEnabled() const {
   return failFast == FailFastMode::Enabled;
 }
 
+bool Config::batchTestsModeEnabled() const {
+  return batchTests == BatchTestsMode::Enabled;
+}
+
+bool Config::zygoteEnabled() const {
+  /// Tests are run in processes forked from the zygote
+  return zygote == ZygoteMode::Enabled && forkEnabled();
+}
+
+bool Config::blockCoverageEnabled() const {
+  /// The blocks are only recorded by the instrumented test runs
+  return blockCoverage == BlockCoverageMode::Enabled &&
+         reachabilityMode != ReachabilityMode::Static &&
+         reachabilityMode != ReachabilityMode::Sampling;
+}
+
+bool Config::callCountsEnabled() const {
+  /// The calls are only counted by the instrumented test runs
+  return callCounts == CallCountsMode::Enabled &&
+         reachabilityMode != ReachabilityMode::Static &&
+         reachabilityMode != ReachabilityMode::Sampling;
+}
+
+bool Config::streamingEnabled() const {
+  return streaming == StreamingMode::Enabled;
+}
+
+bool Config::inlineInstrumentationEnabled() const {
+  return instrumentationMode == InstrumentationMode::Inline;
+}
+
+bool Config::staticReachabilityEnabled() const {
+  return reachabilityMode == ReachabilityMode::Static;
+}
+
+bool Config::hybridReachabilityEnabled() const {
+  return reachabilityMode == ReachabilityMode::Hybrid;
+}
+
+bool Config::samplingReachabilityEnabled() const {
+  return reachabilityMode == ReachabilityMode::Sampling;
+}
+
 bool Config::shouldEmitDebugInfo() const {
   return emitDebugInfo == EmitDebugInfo::Yes;
 }
@@ -320,6 +506,22 @@ bool Config::junkDetectionEnabled() const {
   return junkDetection.isEnabled();
 }
 
+bool Config::inProcessSandboxEnabledFor(const std::string &testName) const {
+  return inProcessSandbox.isEnabledFor(testFramework, testName);
+}
+
+const InProcessSandboxConfig &Config::inProcessSandboxConfig() const {
+  return inProcessSandbox;
+}
+
+const SamplingConfig &Config::samplingConfig() const {
+  return sampling;
+}
+
+bool Config::mutantSamplingEnabled() const {
+  return sampling.isEnabled();
+}
+
 JunkDetectionConfig &Config::junkDetectionConfig() {
   return junkDetection;
 }
@@ -332,6 +534,27 @@ int Config::getMaxDistance() const {
   return maxDistance;
 }
 
+int Config::getExecutionBudget() const {
+  return executionBudget;
+}
+
+bool Config::executionBudgetEnabled() const {
+  /// The budget counters are global to the process running a test
+  return executionBudget > 0 && forkEnabled();
+}
+
+int Config::getTimeBudget() const {
+  return timeBudget;
+}
+
+Config::ReachabilityMode Config::getReachabilityMode() const {
+  return reachabilityMode;
+}
+
+bool Config::timeBudgetEnabled() const {
+  return timeBudget > 0;
+}
+
 std::string Config::getCacheDirectory() const {
   return cacheDirectory;
 }
@@ -344,8 +567,17 @@ void Config::dump() const {
   << "\t" << "project_name: " << getProjectName() << '\n'
   << "\t" << "test_framework: " << getTestFramework() << '\n'
   << "\t" << "distance: " << getMaxDistance() << '\n'
+  << "\t" << "execution_budget: " << getExecutionBudget() << '\n'
+  << "\t" << "time_budget: " << getTimeBudget() << '\n'
   << "\t" << "dry_run: " << dryRunToString(dryRun) << '\n'
   << "\t" << "fail_fast: " << failFastToString(failFast) << '\n'
+  << "\t" << "batch_tests: " << batchTestsToString(batchTests) << '\n'
+  << "\t" << "zygote: " << zygoteToString(zygote) << '\n'
+  << "\t" << "block_coverage: " << blockCoverageToString(blockCoverage) << '\n'
+  << "\t" << "call_counts: " << callCountsToString(callCounts) << '\n'
+  << "\t" << "streaming: " << streamingToString(streaming) << '\n'
+  << "\t" << "instrumentation_mode: " << instrumentationModeToString(instrumentationMode) << '\n'
+  << "\t" << "reachability: " << reachabilityModeToString(reachabilityMode) << '\n'
   << "\t" << "fork: " << forkToString(fork) << '\n'
   << "\t" << "use_cache: " << cachingToString(caching) << '\n'
   << "\t" << "junk_detection: " << (junkDetectionEnabled() ? "enabled" : "disabled" ) << '\n'
@@ -375,6 +607,25 @@ void Config::dump() const {
       Logger::debug() << "\t- " << excludeLocation << '\n';
     }
   }
+
+  if (inProcessSandbox.isEnabled()) {
+    Logger::debug() << "\t" << "in_process_sandbox: " << '\n';
+
+    for (const auto &framework : inProcessSandbox.testFrameworks) {
+      Logger::debug() << "\t\t" << "test_framework: " << framework << '\n';
+    }
+
+    for (const auto &test : inProcessSandbox.tests) {
+      Logger::debug() << "\t\t" << "test: " << test << '\n';
+    }
+  }
+
+  if (sampling.isEnabled()) {
+    Logger::debug() << "\t" << "sampling: " << '\n'
+    << "\t\t" << "size: " << sampling.size << '\n'
+    << "\t\t" << "seed: " << sampling.seed << '\n'
+    << "\t\t" << "interval_width: " << sampling.intervalWidth << '\n';
+  }
 }
 
 std::vector<std::string> Config::validate() {
@@ -418,6 +669,22 @@ std::vector<std::string> Config::validate() {
     }
   }
 
+  if (executionBudget > 0 && !forkEnabled()) {
+    std::string error = "execution_budget parameter requires fork to be enabled.";
+    errors.push_back(error);
+  }
+
+  /// The zygote runs every test in its own process
+  if (zygoteEnabled() && batchTestsModeEnabled()) {
+    std::string error = "zygote parameter cannot be combined with batch_tests.";
+    errors.push_back(error);
+  }
+
+  if (zygoteEnabled() && inProcessSandbox.isEnabled()) {
+    std::string error = "zygote parameter cannot be combined with in_process_sandbox.";
+    errors.push_back(error);
+  }
+
   return errors;
 }
 
@@ -427,6 +694,17 @@ const ParallelizationConfig Config::parallelization() const {
 
 void Config::normalizeParallelizationConfig() {
   parallelizationConfig.normalize();
+
+  /// The tests run within Mull's process share the test runner (its
+  /// trampoline and the program's destructors), the JIT and the state of the
+  /// test framework, hence they cannot run on several workers at once
+  if (!forkEnabled()) {
+    parallelizationConfig.testExecutionWorkers = 1;
+    parallelizationConfig.mutantExecutionWorkers = 1;
+  }
+  if (inProcessSandbox.isEnabled()) {
+    parallelizationConfig.mutantExecutionWorkers = 1;
+  }
 }
 
 ParallelizationConfig::ParallelizationConfig()
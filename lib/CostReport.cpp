@@ -0,0 +1,100 @@
+#include "CostReport.h"
+
+#include "MullModule.h"
+#include "MutantCostModel.h"
+#include "MutationPoint.h"
+#include "Mutators/Mutator.h"
+#include "Parallelization/TaskExecutor.h"
+
+#include <llvm/Support/Format.h>
+
+#include <algorithm>
+
+using namespace mull;
+using namespace llvm;
+
+static void addCost(CostEstimate &estimate, double compileTime,
+                    double executionTime) {
+  estimate.mutants++;
+  estimate.compileTime += compileTime;
+  estimate.executionTime += executionTime;
+}
+
+CostReport::CostReport(const std::vector<MutationPoint *> &points,
+                       MutantCostModel &costModel, size_t workers)
+    : workers(std::max(workers, size_t(1))), total(), modules(), mutators(),
+      projectedWallTime(0) {
+  std::vector<double> costs;
+  costs.reserve(points.size());
+  for (auto point : points) {
+    double compileTime = 0;
+    double executionTime = 0;
+    /// Mutants not covered by any test are neither compiled nor run
+    if (!point->getReachableTests().empty()) {
+      compileTime = costModel.compileTime(point);
+      executionTime = costModel.executionTime(point);
+    }
+    costs.push_back(compileTime + executionTime);
+
+    addCost(total, compileTime, executionTime);
+    addCost(modules[point->getOriginalModule()->getModule()->getModuleIdentifier()],
+            compileTime, executionTime);
+    addCost(mutators[point->getMutator()->getUniqueIdentifier()],
+            compileTime, executionTime);
+  }
+
+  if (costs.empty()) {
+    return;
+  }
+
+  size_t start = 0;
+  for (int batch : taskBatches(costs.size(), std::min(costs.size(), this->workers))) {
+    double batchTime = 0;
+    for (size_t i = start; i < start + batch; i++) {
+      batchTime += costs[i];
+    }
+    projectedWallTime = std::max(projectedWallTime, batchTime);
+    start += batch;
+  }
+}
+
+const CostEstimate &CostReport::getTotal() const {
+  return total;
+}
+
+const std::map<std::string, CostEstimate> &CostReport::getModules() const {
+  return modules;
+}
+
+const std::map<std::string, CostEstimate> &CostReport::getMutators() const {
+  return mutators;
+}
+
+double CostReport::getProjectedWallTime() const {
+  return projectedWallTime;
+}
+
+static void printEstimate(raw_ostream &out, const std::string &name,
+                          const CostEstimate &estimate) {
+  out << "  " << name << ": " << estimate.mutants << " mutants, compile "
+      << format("%.0f", estimate.compileTime) << "ms, execute "
+      << format("%.0f", estimate.executionTime) << "ms\n";
+}
+
+void CostReport::print(raw_ostream &out) const {
+  out << "Predicted cost of " << total.mutants << " mutants: compile "
+      << format("%.0f", total.compileTime) << "ms, execute "
+      << format("%.0f", total.executionTime) << "ms, "
+      << format("%.0f", projectedWallTime) << "ms of wall time on "
+      << workers << " workers\n";
+
+  out << "By module:\n";
+  for (auto &module : modules) {
+    printEstimate(out, module.first, module.second);
+  }
+
+  out << "By mutator:\n";
+  for (auto &mutator : mutators) {
+    printEstimate(out, mutator.first, mutator.second);
+  }
+}
@@ -15,47 +15,64 @@
 using namespace mull;
 using namespace llvm;
 
-CustomTestFinder::CustomTestFinder(const std::vector<CustomTestDefinition> &definitions)
-: testDefinitions(definitions) {}
-
-std::vector<std::unique_ptr<Test>> CustomTestFinder::findTests(Context &context,
-                                                               Filter &filter) {
-  std::map<std::string, size_t> testMapping;
+CustomTestFinder::CustomTestFinder(const std::vector<CustomTestDefinition> &definitions,
+                                   int workers, const std::string &cacheDirectory)
+: ModuleTestFinder(workers, cacheDirectory), testDefinitions(definitions) {
   for (size_t i = 0; i < testDefinitions.size(); i++) {
     const CustomTestDefinition &definition = testDefinitions[i];
     testMapping[definition.methodName] = i;
   }
+}
+
+/// The definitions only decide which functions are tests: the names and the
+/// arguments are taken from the definitions when the tests are created
+std::string CustomTestFinder::discoveryKey() const {
+  std::string key = "CustomTest";
+  for (auto &method : testMapping) {
+    key += " " + method.first;
+  }
+  return key;
+}
+
+std::vector<DiscoveredTest> CustomTestFinder::discoverTests(Module *module) {
+  std::vector<DiscoveredTest> tests;
+
+  for (auto &function: module->getFunctionList()) {
+    if (function.isDeclaration()) {
+      continue;
+    }
 
-  std::vector<std::unique_ptr<Test>> tests;
-
-  for (auto &currentModule : context.getModules()) {
-    for (auto &function: currentModule->getModule()->getFunctionList()) {
-      if (function.isDeclaration()) {
-        continue;
-      }
-
-      const std::string &functionName = function.getName().str();
-      if (testMapping.count(functionName) == 0) {
-        continue;
-      }
-
-      const CustomTestDefinition &definition = testDefinitions[testMapping.at(functionName)];
-      if (filter.shouldSkipTest(definition.testName)) {
-        continue;
-      }
-
-      std::string programName = definition.programName;
-      if (programName.empty()) {
-        programName = "mull";
-      }
-
-      tests.emplace_back(make_unique<CustomTest_Test>(definition.testName,
-                                                      programName,
-                                                      definition.callArguments,
-                                                      &function,
-                                                      context.getStaticConstructors()));
+    const std::string &functionName = function.getName().str();
+    auto mapping = testMapping.find(functionName);
+    if (mapping == testMapping.end()) {
+      continue;
     }
+
+    const CustomTestDefinition &definition = testDefinitions[mapping->second];
+    tests.emplace_back(definition.testName, functionName);
   }
 
   return tests;
 }
+
+std::unique_ptr<Test>
+CustomTestFinder::createTest(const DiscoveredTest &test, Function *entryPoint,
+                             const std::vector<Function *> &constructors,
+                             Filter &filter) {
+  const CustomTestDefinition &definition =
+      testDefinitions[testMapping.at(test.entryPoint)];
+  if (filter.shouldSkipTest(definition.testName)) {
+    return nullptr;
+  }
+
+  std::string programName = definition.programName;
+  if (programName.empty()) {
+    programName = "mull";
+  }
+
+  return make_unique<CustomTest_Test>(definition.testName,
+                                      programName,
+                                      definition.callArguments,
+                                      entryPoint,
+                                      constructors);
+}
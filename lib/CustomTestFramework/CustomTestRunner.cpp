@@ -1,6 +1,7 @@
 #include "CustomTestFramework/CustomTestRunner.h"
 #include "CustomTestFramework/CustomTest_Test.h"
 
+#include "Instrumentation/Callbacks.h"
 #include "Toolchain/Resolvers/InstrumentationResolver.h"
 #include "Toolchain/Resolvers/NativeResolver.h"
 
@@ -68,7 +69,7 @@ void CustomTestRunner::loadProgram(ObjectFiles &objectFiles,
 }
 
 ExecutionStatus CustomTestRunner::runTest(Test *test, JITEngine &jit) {
-  *trampoline = &test->getInstrumentationInfo();
+  Callbacks::setInstrumentationInfo(trampoline, &test->getInstrumentationInfo());
 
   CustomTest_Test *customTest = dyn_cast<CustomTest_Test>(test);
 
@@ -14,11 +14,19 @@
 #include "JunkDetection/JunkDetector.h"
 #include "Toolchain/JITEngine.h"
 #include "Parallelization/Parallelization.h"
+#include "ReachabilityCache.h"
+#include "StaticCallGraph.h"
+#include "Instrumentation/SamplingProfiler.h"
+#include "MutantCostModel.h"
+#include "CostReport.h"
+#include "MutationSampler.h"
+#include "RunPlanner.h"
 
 #include <llvm/Support/DynamicLibrary.h>
 
 #include <algorithm>
 #include <fstream>
+#include <random>
 #include <vector>
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -52,19 +60,61 @@ Driver::~Driver() {
 /// all the results of each mutant within corresponding MutationPoint
 
 std::unique_ptr<Result> Driver::Run() {
+  startTime = std::chrono::steady_clock::now();
   loadBitcodeFilesIntoMemory();
-  compileInstrumentedBitcodeFiles();
-  loadPrecompiledObjectFiles();
   loadDynamicLibraries();
 
+  /// Zygotes are forked as early as they can be: the tests are shared with
+  /// them by pointer, so only the modules and the tests are in the image
+  /// every zygote inherits, nothing is compiled or cached yet
   auto tests = findTests();
-  auto mutationPoints = findMutationPoints(tests);
-  auto nonJunkMutationPoints = filterOutJunkMutations(std::move(mutationPoints));
-  auto mutationResults = runMutations(nonJunkMutationPoints);
+  startZygotes();
+
+  if (config.cachingEnabled()) {
+    reachabilityCache = make_unique<ReachabilityCache>(config, context);
+  }
+
+  samplingReachability = config.samplingReachabilityEnabled();
+  if (samplingReachability && !SamplingProfiler::isSupported()) {
+    Logger::warn() << "Cannot sample call stacks (see perf_event_paranoid), "
+                   << "falling back to 'reachability: dynamic'\n";
+    samplingReachability = false;
+  }
 
-  return make_unique<Result>(std::move(tests),
-                             std::move(mutationResults),
-                             std::move(nonJunkMutationPoints));
+  if (needsInstrumentedProgram(tests)) {
+    compileInstrumentedBitcodeFiles(tests);
+  }
+  loadPrecompiledObjectFiles();
+
+  std::vector<MutationPoint *> nonJunkMutationPoints;
+  std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  std::unique_ptr<MutationSampler> sampler;
+  if (config.mutantSamplingEnabled()) {
+    /// The sample is drawn from all the mutants, hence no streaming
+    auto &sampling = config.samplingConfig();
+    uint32_t seed = sampling.seed != 0 ? sampling.seed : std::random_device()();
+    sampler = make_unique<MutationSampler>(seed, sampling.size);
+
+    auto mutationPoints = findMutationPoints(tests);
+    nonJunkMutationPoints = filterOutJunkMutations(std::move(mutationPoints));
+    mutationResults = runSampledMutations(nonJunkMutationPoints, *sampler);
+  } else if (config.timeBudgetEnabled()) {
+    auto mutationPoints = findMutationPoints(tests);
+    nonJunkMutationPoints = filterOutJunkMutations(std::move(mutationPoints));
+    mutationResults = runBudgetedMutations(nonJunkMutationPoints);
+  } else if (config.streamingEnabled()) {
+    streamMutations(tests, nonJunkMutationPoints, mutationResults);
+  } else {
+    auto mutationPoints = findMutationPoints(tests);
+    nonJunkMutationPoints = filterOutJunkMutations(std::move(mutationPoints));
+    mutationResults = runMutations(nonJunkMutationPoints);
+  }
+
+  auto result = make_unique<Result>(std::move(tests),
+                                    std::move(mutationResults),
+                                    std::move(nonJunkMutationPoints));
+  result->setSampler(std::move(sampler));
+  return result;
 }
 
 void Driver::loadBitcodeFilesIntoMemory() {
@@ -80,7 +130,7 @@ void Driver::loadBitcodeFilesIntoMemory() {
   }
 }
 
-void Driver::compileInstrumentedBitcodeFiles() {
+void Driver::compileInstrumentedBitcodeFiles(const std::vector<std::unique_ptr<Test>> &tests) {
   metrics.beginInstrumentedCompilation();
 
   for (auto &ownedModule : context.getModules()) {
@@ -88,9 +138,14 @@ void Driver::compileInstrumentedBitcodeFiles() {
     instrumentation.recordFunctions(module.getModule());
   }
 
+  if (config.hybridReachabilityEnabled()) {
+    StaticCallGraph callGraph(context);
+    instrumentation.instrumentOnly(callGraph.reachableFunctions(tests));
+  }
+
   std::vector<InstrumentedCompilationTask> tasks;
   for (int i = 0; i < config.parallelization().workers; i++) {
-    tasks.emplace_back(instrumentation, toolchain);
+    tasks.emplace_back(instrumentation, toolchain, config);
   }
 
   TaskExecutor<InstrumentedCompilationTask> compiler("Compiling instrumented code",
@@ -133,22 +188,128 @@ std::vector<std::unique_ptr<Test>> Driver::findTests() {
   return tests;
 }
 
+void Driver::startZygotes() {
+  if (!config.zygoteEnabled() || config.dryRunModeEnabled()) {
+    return;
+  }
+
+  for (int i = 0; i < config.parallelization().mutantExecutionWorkers; i++) {
+    zygotes.emplace_back(make_unique<Zygote>(runner));
+  }
+}
+
+bool Driver::needsInstrumentedProgram(const std::vector<std::unique_ptr<Test>> &tests) {
+  if (config.staticReachabilityEnabled() || samplingReachability) {
+    return false;
+  }
+  /// The instrumented code is only needed to run the tests whose results
+  /// are not cached yet
+  return !originalTestResultsCached(tests);
+}
+
+bool Driver::originalTestResultsCached(const std::vector<std::unique_ptr<Test>> &tests) {
+  return reachabilityCache && reachabilityCache->containsAll(tests);
+}
+
 std::vector<MutationPoint *>
 Driver::findMutationPoints(std::vector<std::unique_ptr<Test>> &tests) {
   if (tests.empty()) {
     return std::vector<MutationPoint *>();
   }
 
-  auto objectFiles = AllInstrumentedObjectFiles();
+  auto mergedTestees = findTestees(tests);
+  return mutationsFinder.getMutationPoints(context, mergedTestees, filter);
+}
+
+std::vector<MergedTestee> Driver::findTestees(std::vector<std::unique_ptr<Test>> &tests) {
+  std::vector<std::unique_ptr<Testee>> testees;
+  if (config.staticReachabilityEnabled()) {
+    testees = findStaticTestees(tests);
+  } else {
+    testees = runOriginalTests(tests);
+  }
+
+  {
+    /// Cleans up the memory allocated for the vector itself as well
+    std::vector<OwningBinary<ObjectFile>>().swap(instrumentedObjectFiles);
+  }
+
+  return mergeTestees(testees);
+}
+
+/// Number of testees searched, filtered and run at a time,
+/// see 'streaming' option
+static const size_t StreamingBatchSize = 64;
+
+void Driver::streamMutations(std::vector<std::unique_ptr<Test>> &tests,
+                             std::vector<MutationPoint *> &nonJunkMutationPoints,
+                             std::vector<std::unique_ptr<MutationResult>> &mutationResults) {
+  if (tests.empty()) {
+    return;
+  }
+
+  auto mergedTestees = findTestees(tests);
+
+  metrics.beginMutantsExecution();
+  for (size_t begin = 0; begin < mergedTestees.size(); begin += StreamingBatchSize) {
+    size_t end = std::min(mergedTestees.size(), begin + StreamingBatchSize);
+    Logger::info() << "Testees " << begin + 1 << ".." << end
+                   << " of " << mergedTestees.size() << "\n";
+
+    std::vector<MergedTestee> batch(mergedTestees.begin() + begin,
+                                    mergedTestees.begin() + end);
+    auto mutationPoints = mutationsFinder.getMutationPoints(context, batch, filter);
+    auto batchPoints = filterOutJunkMutations(std::move(mutationPoints));
+    mutationsFinder.discardMutationPoints(batchPoints);
+
+    auto batchResults = executeMutations(batchPoints);
+    for (auto &result : batchResults) {
+      mutationResults.push_back(std::move(result));
+    }
+    nonJunkMutationPoints.insert(nonJunkMutationPoints.end(),
+                                 batchPoints.begin(), batchPoints.end());
+  }
+  metrics.endMutantsExecution();
+}
+
+std::vector<std::unique_ptr<Testee>>
+Driver::findStaticTestees(std::vector<std::unique_ptr<Test>> &tests) {
+  metrics.beginOriginalTestExecution();
+  StaticCallGraph callGraph(context);
+
+  std::vector<std::unique_ptr<Testee>> testees;
+  for (auto &test : tests) {
+    auto testTestees = callGraph.getTestees(test.get(), filter, config.getMaxDistance());
+    for (auto &testee : testTestees) {
+      testees.push_back(std::move(testee));
+    }
+  }
+  metrics.endOriginalTestExecution();
+
+  return testees;
+}
+
+std::vector<std::unique_ptr<Testee>>
+Driver::runOriginalTests(std::vector<std::unique_ptr<Test>> &tests) {
   JITEngine jit;
 
-  metrics.beginLoadOriginalProgram();
-  runner.loadInstrumentedProgram(objectFiles, instrumentation, jit);
-  metrics.endLoadOriginalProgram();
+  std::unique_ptr<SamplingProfiler> profiler;
+
+  if (needsInstrumentedProgram(tests)) {
+    auto objectFiles = AllInstrumentedObjectFiles();
+    metrics.beginLoadOriginalProgram();
+    runner.loadInstrumentedProgram(objectFiles, instrumentation, jit);
+    metrics.endLoadOriginalProgram();
+  } else if (samplingReachability && !originalTestResultsCached(tests)) {
+    profiler = loadSampledProgram(jit);
+  }
 
+  /// Without fork the tests share the runner and the process-wide trampoline,
+  /// hence the config normalization leaves a single worker then
   std::vector<OriginalTestExecutionTask> tasks;
   for (int i = 0; i < config.parallelization().testExecutionWorkers; i++) {
-    tasks.emplace_back(instrumentation, *sandbox, runner, config, filter, jit);
+    tasks.emplace_back(instrumentation, *sandbox, runner, config, filter, jit,
+                       reachabilityCache.get(), profiler.get());
   }
 
   metrics.beginOriginalTestExecution();
@@ -157,26 +318,40 @@ Driver::findMutationPoints(std::vector<std::unique_ptr<Test>> &tests) {
   testRunner.execute();
   metrics.endOriginalTestExecution();
 
-  auto mergedTestees = mergeTestees(testees);
-  std::vector<MutationPoint *> mutationPoints = mutationsFinder.getMutationPoints(context, mergedTestees, filter);
+  if (reachabilityCache) {
+    reachabilityCache->save();
+  }
 
-  {
-    /// Cleans up the memory allocated for the vector itself as well
-    std::vector<OwningBinary<ObjectFile>>().swap(instrumentedObjectFiles);
+  return testees;
+}
+
+std::unique_ptr<SamplingProfiler> Driver::loadSampledProgram(JITEngine &jit) {
+  for (auto &ownedModule : context.getModules()) {
+    MullModule &module = *ownedModule;
+    instrumentation.recordFunctions(module.getModule());
   }
 
-  return mutationPoints;
+  /// The same object files are used to run the mutants later
+  compileOriginalBitcodeFiles();
+
+  auto objectFiles = AllButOne(nullptr);
+  metrics.beginLoadOriginalProgram();
+  runner.loadProgram(objectFiles, jit);
+  metrics.endLoadOriginalProgram();
+
+  return make_unique<SamplingProfiler>(instrumentation.getFunctions(), jit);
 }
 
 std::vector<MutationPoint *>
 Driver::filterOutJunkMutations(std::vector<MutationPoint *> mutationPoints) {
   std::vector<MutationPoint *> nonJunkMutationPoints;
   if (config.junkDetectionEnabled()) {
+    auto translationUnits = JunkDetectionTask::groupByTranslationUnit(mutationPoints);
     std::vector<JunkDetectionTask> tasks;
     for (int i = 0; i < config.parallelization().workers; i++) {
       tasks.emplace_back(junkDetector);
     }
-    TaskExecutor<JunkDetectionTask> mutantRunner("Filtering out junk mutations", mutationPoints, nonJunkMutationPoints, std::move(tasks));
+    TaskExecutor<JunkDetectionTask> mutantRunner("Filtering out junk mutations", translationUnits, nonJunkMutationPoints, std::move(tasks));
     mutantRunner.execute();
   } else {
     mutationPoints.swap(nonJunkMutationPoints);
@@ -191,6 +366,126 @@ Driver::runMutations(std::vector<MutationPoint *> &mutationPoints) {
     return std::vector<std::unique_ptr<MutationResult>>();
   }
 
+  metrics.beginMutantsExecution();
+  auto mutationResults = executeMutations(mutationPoints);
+  metrics.endMutantsExecution();
+
+  return mutationResults;
+}
+
+/// Smallest number of sampled mutants to run before the run may stop early,
+/// the interval of a smaller sample is not trusted
+static const size_t MinimumSampledMutants = 30;
+
+std::vector<std::unique_ptr<MutationResult>>
+Driver::runSampledMutations(std::vector<MutationPoint *> &mutationPoints,
+                            MutationSampler &sampler) {
+  auto sample = sampler.sample(mutationPoints);
+  Logger::info() << "Sampled " << sample.size() << " of "
+                 << mutationPoints.size() << " mutants in "
+                 << sampler.getStrata().size() << " strata, seed "
+                 << sampler.getSeed() << "\n";
+
+  /// Without a target width the whole sample is run at once, otherwise the
+  /// interval is checked after each chunk
+  double targetWidth = config.samplingConfig().intervalWidth / 100.0;
+  size_t chunkSize = sample.size();
+  if (targetWidth > 0 && !config.dryRunModeEnabled()) {
+    size_t workers = config.parallelization().mutantExecutionWorkers;
+    chunkSize = std::max(MinimumSampledMutants, 4 * workers);
+  }
+
+  std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  std::vector<MutationPoint *> executedPoints;
+
+  metrics.beginMutantsExecution();
+  for (size_t begin = 0; begin < sample.size(); begin += chunkSize) {
+    size_t end = std::min(sample.size(), begin + chunkSize);
+    std::vector<MutationPoint *> chunk(sample.begin() + begin,
+                                       sample.begin() + end);
+
+    auto chunkResults = executeMutations(chunk);
+    sampler.record(chunkResults);
+    for (auto &result : chunkResults) {
+      mutationResults.push_back(std::move(result));
+    }
+    executedPoints.insert(executedPoints.end(), chunk.begin(), chunk.end());
+
+    auto estimate = sampler.estimate();
+    if (end < sample.size() && estimate.executed >= MinimumSampledMutants &&
+        estimate.width() <= targetWidth) {
+      Logger::info() << "Confidence interval is narrow enough, skipping the "
+                     << sample.size() - end << " remaining sampled mutants\n";
+      break;
+    }
+  }
+  metrics.endMutantsExecution();
+
+  if (!config.dryRunModeEnabled()) {
+    auto estimate = sampler.estimate();
+    Logger::info() << "Estimated mutation score: " << estimate.score * 100
+                   << "%, 95% confidence interval " << estimate.lower * 100
+                   << "%.." << estimate.upper * 100 << "% ("
+                   << estimate.executed << " of " << sampler.getPopulation()
+                   << " mutants run)\n";
+  }
+
+  mutationPoints.swap(executedPoints);
+  return mutationResults;
+}
+
+std::vector<std::unique_ptr<MutationResult>>
+Driver::runBudgetedMutations(const std::vector<MutationPoint *> &mutationPoints) {
+  using namespace std::chrono;
+
+  int workers = config.parallelization().mutantExecutionWorkers;
+  MutantCostModel costModel(config.failFastModeEnabled());
+  RunPlanner planner(mutationPoints, costModel, workers);
+  auto deadline = startTime + seconds(config.getTimeBudget());
+  size_t chunkSize = std::max<size_t>(32, 4 * workers);
+
+  std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  size_t executed = 0;
+
+  metrics.beginMutantsExecution();
+  while (true) {
+    auto chunkStart = steady_clock::now();
+    double remainingTime = duration_cast<milliseconds>(deadline - chunkStart).count();
+    auto chunk = planner.nextChunk(remainingTime, chunkSize);
+    if (chunk.empty()) {
+      break;
+    }
+
+    auto chunkResults = executeMutations(chunk);
+    planner.calibrate(duration_cast<milliseconds>(steady_clock::now() - chunkStart).count());
+    for (auto &result : chunkResults) {
+      mutationResults.push_back(std::move(result));
+    }
+    executed += chunk.size();
+  }
+
+  auto skipped = planner.remaining();
+  for (auto point : skipped) {
+    ExecutionResult result;
+    result.status = ExecutionStatus::Skipped;
+    mutationResults.push_back(make_unique<MutationResult>(result, point, -1, nullptr));
+  }
+  metrics.endMutantsExecution();
+
+  Logger::info() << "Ran " << executed << " of " << mutationPoints.size()
+                 << " mutants within the time budget, " << skipped.size()
+                 << " skipped (predicted costs corrected by "
+                 << planner.getCalibration() << "x)\n";
+
+  return mutationResults;
+}
+
+std::vector<std::unique_ptr<MutationResult>>
+Driver::executeMutations(const std::vector<MutationPoint *> &mutationPoints) {
+  if (mutationPoints.empty()) {
+    return std::vector<std::unique_ptr<MutationResult>>();
+  }
+
   if (config.dryRunModeEnabled()) {
     return dryRunMutations(mutationPoints);
   }
@@ -206,20 +501,27 @@ Driver::dryRunMutations(const std::vector<MutationPoint *> &mutationPoints) {
 
   std::vector<DryRunMutantExecutionTask> tasks;
   for (int i = 0; i < config.parallelization().workers; i++) {
-    tasks.emplace_back(DryRunMutantExecutionTask());
+    tasks.emplace_back(config.failFastModeEnabled());
   }
-  metrics.beginMutantsExecution();
   TaskExecutor<DryRunMutantExecutionTask> mutantRunner("Running mutants (dry run)", mutationPoints, mutationResults, std::move(tasks));
   mutantRunner.execute();
-  metrics.endMutantsExecution();
+
+  MutantCostModel costModel(config.failFastModeEnabled());
+  CostReport costReport(mutationPoints, costModel,
+                        config.parallelization().mutantExecutionWorkers);
+  costReport.print(Logger::info());
 
   return mutationResults;
 }
 
-std::vector<std::unique_ptr<MutationResult>> Driver::normalRunMutations(const std::vector<MutationPoint *> &mutationPoints) {
+void Driver::compileOriginalBitcodeFiles() {
+  if (!ownedObjectFiles.empty()) {
+    return;
+  }
+
   std::vector<OriginalCompilationTask> compilationTasks;
   for (int i = 0; i < config.parallelization().workers; i++) {
-    compilationTasks.emplace_back(toolchain);
+    compilationTasks.emplace_back(toolchain, config);
   }
   TaskExecutor<OriginalCompilationTask> mutantCompiler("Compiling original code", context.getModules(), ownedObjectFiles, std::move(compilationTasks));
   mutantCompiler.execute();
@@ -229,17 +531,20 @@ std::vector<std::unique_ptr<MutationResult>> Driver::normalRunMutations(const st
     auto &objectFile = ownedObjectFiles.at(i);
     innerCache.insert(std::make_pair(module->getModule(), objectFile.getBinary()));
   }
+}
+
+std::vector<std::unique_ptr<MutationResult>> Driver::normalRunMutations(const std::vector<MutationPoint *> &mutationPoints) {
+  compileOriginalBitcodeFiles();
 
   std::vector<std::unique_ptr<MutationResult>> mutationResults;
 
   std::vector<MutantExecutionTask> tasks;
   for (int i = 0; i < config.parallelization().mutantExecutionWorkers; i++) {
-    tasks.emplace_back(*this, *sandbox, runner, config, toolchain, filter);
+    Zygote *zygote = zygotes.empty() ? nullptr : zygotes.at(i).get();
+    tasks.emplace_back(*this, *sandbox, runner, config, toolchain, filter, zygote);
   }
-  metrics.beginMutantsExecution();
   TaskExecutor<MutantExecutionTask> mutantRunner("Running mutants", mutationPoints, mutationResults, std::move(tasks));
   mutantRunner.execute();
-  metrics.endMutantsExecution();
 
   return mutationResults;
 }
@@ -284,7 +589,7 @@ Driver::Driver(Config &C,
                Metrics &metrics,
                JunkDetector &junkDetector)
     : config(C), loader(ML), finder(TF), runner(TR), toolchain(t), filter(f), mutationsFinder(mutationsFinder),
-      precompiledObjectFiles(), instrumentation(), metrics(metrics), junkDetector(junkDetector) {
+      precompiledObjectFiles(), instrumentation(C.blockCoverageEnabled(), C.inlineInstrumentationEnabled(), C.callCountsEnabled()), samplingReachability(false), metrics(metrics), junkDetector(junkDetector) {
 
   if (C.forkEnabled()) {
     this->sandbox = new ForkProcessSandbox();
@@ -4,45 +4,83 @@
 #include <llvm/IR/DebugInfoMetadata.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/Support/Path.h>
 #include "SourceLocation.h"
 
 using namespace llvm;
 using namespace mull;
 
+bool Filter::shouldSkipPath(const std::string &filePath) {
+  return locations.matches(filePath);
+}
+
+bool Filter::shouldSkipFile(const DIFile *file) {
+  {
+    std::lock_guard<std::mutex> lock(verdictsMutex);
+    auto verdict = fileVerdicts.find(file);
+    if (verdict != fileVerdicts.end()) {
+      return verdict->second;
+    }
+  }
+
+  /// The same path as SourceLocation gives
+  std::string filePath = file->getFilename().str();
+  if (!sys::path::is_absolute(filePath)) {
+    filePath = file->getDirectory().str() + sys::path::get_separator().str() + filePath;
+  }
+  bool skip = shouldSkipPath(filePath);
+
+  std::lock_guard<std::mutex> lock(verdictsMutex);
+  fileVerdicts[file] = skip;
+  return skip;
+}
+
 bool Filter::shouldSkipInstruction(llvm::Instruction *instruction) {
-  SourceLocation location = SourceLocation::sourceLocationFromInstruction(instruction);
-  if (location.isNull()) {
+  if (locations.empty() || instruction->getMetadata(0) == nullptr) {
     return false;
   }
 
-  for (auto &fileLocation : locations) {
-    if (location.filePath.find(fileLocation) != std::string::npos) {
-      return true;
-    }
+  const DebugLoc &debugInfo = instruction->getDebugLoc();
+  if (!debugInfo) {
+    return false;
+  }
+
+  DIScope *scope = debugInfo->getScope();
+  if (scope && scope->getFile()) {
+    return shouldSkipFile(scope->getFile());
   }
 
-  return false;
+  SourceLocation location = SourceLocation::sourceLocationFromInstruction(instruction);
+  if (location.isNull()) {
+    return false;
+  }
+  return shouldSkipPath(location.filePath);
 }
 
 bool Filter::shouldSkipFunction(llvm::Function *function) {
-  for (std::string &name : names) {
-    if (function->getName().find(StringRef(name)) != StringRef::npos) {
-      return true;
+  {
+    std::lock_guard<std::mutex> lock(verdictsMutex);
+    auto verdict = functionVerdicts.find(function);
+    if (verdict != functionVerdicts.end()) {
+      return verdict->second;
     }
   }
 
-  SourceLocation location = SourceLocation::sourceLocationFromFunction(function);
-  if (location.isNull()) {
-    return false;
-  }
+  bool skip = names.matches(function->getName());
 
-  for (auto &fileLocation : locations) {
-    if (location.filePath.find(fileLocation) != std::string::npos) {
-      return true;
+  if (!skip && !locations.empty() && function->getMetadata(0) != nullptr) {
+    auto subprogram = dyn_cast<DISubprogram>(function->getMetadata(0));
+    if (subprogram && subprogram->getFile()) {
+      skip = shouldSkipFile(subprogram->getFile());
+    } else if (subprogram) {
+      SourceLocation location = SourceLocation::sourceLocationFromFunction(function);
+      skip = !location.isNull() && shouldSkipPath(location.filePath);
     }
   }
 
-  return false;
+  std::lock_guard<std::mutex> lock(verdictsMutex);
+  functionVerdicts[function] = skip;
+  return skip;
 }
 
 bool Filter::shouldSkipTest(const std::string &testName) {
@@ -59,19 +97,19 @@ bool Filter::shouldSkipTest(const std::string &testName) {
 }
 
 void Filter::skipByName(const std::string &nameSubstring) {
-  names.push_back(nameSubstring);
+  names.addPattern(nameSubstring);
 }
 
 void Filter::skipByName(const char *nameSubstring) {
-  names.push_back(std::string(nameSubstring));
+  names.addPattern(std::string(nameSubstring));
 }
 
 void Filter::skipByLocation(const std::string &locationSubstring) {
-  locations.push_back(locationSubstring);
+  locations.addPattern(locationSubstring);
 }
 
 void Filter::skipByLocation(const char *locationSubstring) {
-  locations.push_back(std::string(locationSubstring));
+  locations.addPattern(std::string(locationSubstring));
 }
 
 void Filter::includeTest(const std::string &testName) {
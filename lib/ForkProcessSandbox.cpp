@@ -2,11 +2,15 @@
 
 #include "Logger.h"
 #include "ExecutionResult.h"
+#include "Instrumentation/ExecutionBudget.h"
 
 #include <cerrno>
 #include <chrono>
 #include <csignal>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <setjmp.h>
 #include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -15,6 +19,15 @@
 #include <unistd.h>
 #include <llvm/Support/FileSystem.h>
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <time.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
 using namespace std::chrono;
 
 static pid_t mullFork(const char *processName) {
@@ -96,13 +109,18 @@ mull::ForkProcessSandbox::run(std::function<ExecutionStatus (void)> function,
   llvm::SmallString<32> stdoutFilename;
   llvm::sys::fs::createUniqueFile("/tmp/mull.stdout.%%%%%%", stdoutFilename);
 
+  struct SharedResult {
+    ExecutionStatus status;
+    uint64_t executionSteps;
+  };
+
   /// Creating a memory to be shared between child and parent.
-  ExecutionStatus *sharedStatus = (ExecutionStatus *)mmap(nullptr,
-                                                          sizeof(ExecutionStatus),
-                                                          PROT_READ | PROT_WRITE,
-                                                          MAP_SHARED | MAP_ANONYMOUS,
-                                                          -1,
-                                                          0);
+  SharedResult *sharedResult = (SharedResult *)mmap(nullptr,
+                                                    sizeof(SharedResult),
+                                                    PROT_READ | PROT_WRITE,
+                                                    MAP_SHARED | MAP_ANONYMOUS,
+                                                    -1,
+                                                    0);
 
   auto start = high_resolution_clock::now();
   const pid_t workerPID = mullFork("worker");
@@ -112,7 +130,8 @@ mull::ForkProcessSandbox::run(std::function<ExecutionStatus (void)> function,
 
     handle_timeout(timeoutMilliseconds);
 
-    *sharedStatus = function();
+    sharedResult->status = function();
+    sharedResult->executionSteps = ExecutionBudget::steps();
 
     fflush(stderr);
     fflush(stdout);
@@ -128,9 +147,10 @@ mull::ForkProcessSandbox::run(std::function<ExecutionStatus (void)> function,
     result.exitStatus = WEXITSTATUS(status);
     result.stderrOutput = readFileAndUnlink(stderrFilename.c_str());
     result.stdoutOutput = readFileAndUnlink(stdoutFilename.c_str());
-    result.status = *sharedStatus;
+    result.status = sharedResult->status;
+    result.executionSteps = sharedResult->executionSteps;
 
-    int munmapResult = munmap(sharedStatus, sizeof(ExecutionStatus));
+    int munmapResult = munmap(sharedResult, sizeof(SharedResult));
 
     /// Check that mummap succeeds:
     /// "On success, munmap() returns 0, on failure -1, and errno is set (probably to EINVAL)."
@@ -154,9 +174,205 @@ mull::ForkProcessSandbox::run(std::function<ExecutionStatus (void)> function,
   }
 }
 
+void mull::ForkProcessSandbox::restartTimeout(long long timeoutMilliseconds) {
+  handle_timeout(timeoutMilliseconds);
+}
+
 mull::ExecutionResult mull::NullProcessSandbox::run(std::function<ExecutionStatus (void)> function,
                                                     long long timeoutMilliseconds) {
   ExecutionResult result;
   result.status = function();
+  result.executionSteps = ExecutionBudget::steps();
+  return result;
+}
+
+#pragma mark - In-process sandbox
+
+namespace {
+
+struct InProcessContext {
+  sigjmp_buf jumpBuffer;
+};
+
+/// Context of the sandboxed function running on the current thread
+thread_local InProcessContext *currentContext = nullptr;
+
+const int crashSignals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+const size_t crashSignalsCount = sizeof(crashSignals) / sizeof(crashSignals[0]);
+struct sigaction previousActions[crashSignalsCount];
+
+const size_t alternateStackSize = 64 * 1024;
+
+int timeoutSignal() {
+  return SIGRTMIN;
+}
+
+}
+
+static void handle_in_process_signal(int signal, siginfo_t *info, void *context);
+
+static struct sigaction inProcessSignalAction() {
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = &handle_in_process_signal;
+  action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+  sigemptyset(&action.sa_mask);
+  return action;
+}
+
+/// Runs the previous handler of the signal, and keeps ours installed
+/// for the crashes of the sandboxed functions that come later
+static void forwardSignal(const struct sigaction &previous, int signal,
+                          siginfo_t *info, void *context) {
+  if (previous.sa_flags & SA_SIGINFO) {
+    previous.sa_sigaction(signal, info, context);
+    return;
+  }
+  if (previous.sa_handler == SIG_IGN) {
+    return;
+  }
+  if (previous.sa_handler != SIG_DFL) {
+    previous.sa_handler(signal);
+    return;
+  }
+
+  /// The default action: the signal is blocked while it is handled, so it
+  /// has to be unblocked to take effect right away
+  sigaction(signal, &previous, nullptr);
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, signal);
+  pthread_sigmask(SIG_UNBLOCK, &signals, nullptr);
+  raise(signal);
+
+  /// Only reached if the default action does not terminate the process
+  struct sigaction action = inProcessSignalAction();
+  sigaction(signal, &action, nullptr);
+}
+
+static void handle_in_process_signal(int signal, siginfo_t *info, void *context) {
+  InProcessContext *inProcessContext = currentContext;
+  if (inProcessContext == nullptr) {
+    /// The timer may fire right after the function has returned
+    if (signal == timeoutSignal() || signal == SIGALRM) {
+      return;
+    }
+
+    /// The signal did not come from a sandboxed function: give it to
+    /// whoever was handling it before us
+    for (size_t i = 0; i < crashSignalsCount; i++) {
+      if (crashSignals[i] == signal) {
+        forwardSignal(previousActions[i], signal, info, context);
+      }
+    }
+    return;
+  }
+
+  currentContext = nullptr;
+  siglongjmp(inProcessContext->jumpBuffer, signal);
+}
+
+static void installInProcessSignalHandlers() {
+  static std::once_flag installed;
+  std::call_once(installed, []() {
+    struct sigaction action = inProcessSignalAction();
+
+    for (size_t i = 0; i < crashSignalsCount; i++) {
+      if (sigaction(crashSignals[i], &action, &previousActions[i]) != 0) {
+        perror("sigaction");
+        abort();
+      }
+    }
+
+    /// SIGALRM is raised when a test runs out of its ExecutionBudget
+    if (sigaction(timeoutSignal(), &action, nullptr) != 0 ||
+        sigaction(SIGALRM, &action, nullptr) != 0) {
+      perror("sigaction");
+      abort();
+    }
+  });
+}
+
+bool mull::InProcessSandbox::isSupported() {
+#if defined(__linux__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+mull::ExecutionResult
+mull::InProcessSandbox::run(std::function<ExecutionStatus (void)> function,
+                            long long timeoutMilliseconds) {
+#if defined(__linux__)
+  installInProcessSignalHandlers();
+
+  /// A stack overflow cannot be handled on the stack that overflowed
+  thread_local std::unique_ptr<char[]> alternateStackMemory;
+  if (!alternateStackMemory) {
+    alternateStackMemory.reset(new char[alternateStackSize]);
+  }
+
+  stack_t alternateStack;
+  alternateStack.ss_sp = alternateStackMemory.get();
+  alternateStack.ss_size = alternateStackSize;
+  alternateStack.ss_flags = 0;
+
+  stack_t previousStack;
+  if (sigaltstack(&alternateStack, &previousStack) != 0) {
+    perror("sigaltstack");
+    abort();
+  }
+
+  struct sigevent event;
+  memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = timeoutSignal();
+  event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+
+  timer_t timer;
+  if (timer_create(CLOCK_MONOTONIC, &event, &timer) != 0) {
+    perror("timer_create");
+    abort();
+  }
+
+  struct itimerspec timerValue;
+  memset(&timerValue, 0, sizeof(timerValue));
+  timerValue.it_value.tv_sec = timeoutMilliseconds / 1000;
+  /// Cut off seconds, and convert what's left into nanoseconds
+  timerValue.it_value.tv_nsec = (timeoutMilliseconds % 1000) * 1000000;
+
+  ExecutionResult result;
+  InProcessContext context;
+
+  auto start = high_resolution_clock::now();
+  int signal = sigsetjmp(context.jumpBuffer, 1);
+  if (signal == 0) {
+    currentContext = &context;
+    /// Armed only now: the handler ignores a timeout that fires before
+    /// there is a context to jump back to
+    if (timer_settime(timer, 0, &timerValue, nullptr) != 0) {
+      currentContext = nullptr;
+      perror("timer_settime");
+      abort();
+    }
+    result.status = function();
+    currentContext = nullptr;
+  } else if (signal == timeoutSignal() || signal == SIGALRM) {
+    result.status = Timedout;
+  } else {
+    result.status = Crashed;
+  }
+
+  timer_delete(timer);
+  auto elapsed = high_resolution_clock::now() - start;
+  result.runningTime = duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+  sigaltstack(&previousStack, nullptr);
+
   return result;
+#else
+  Logger::error() << "In-process sandbox is not supported on this platform\n";
+  exit(1);
+#endif
 }
@@ -2,16 +2,25 @@
 
 #include "GoogleTest/GoogleTest_Test.h"
 #include "Mangler.h"
+#include "ForkProcessSandbox.h"
+#include "TestBatch.h"
+#include "Instrumentation/ExecutionBudget.h"
 
+#include "Instrumentation/Callbacks.h"
 #include "Toolchain/Resolvers/InstrumentationResolver.h"
 #include "Toolchain/Resolvers/NativeResolver.h"
 
 #include <llvm/IR/Function.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 
+#include <chrono>
+#include <string>
+#include <unistd.h>
+
 using namespace mull;
 using namespace llvm;
 using namespace llvm::orc;
+using namespace std::chrono;
 
 namespace {
   class UnitTest;
@@ -26,7 +35,10 @@ GoogleTestRunner::GoogleTestRunner(llvm::TargetMachine &machine) :
   fGoogleTestInit(mangler.getNameWithPrefix("_ZN7testing14InitGoogleTestEPiPPc")),
   fGoogleTestInstance(mangler.getNameWithPrefix("_ZN7testing8UnitTest11GetInstanceEv")),
   fGoogleTestRun(mangler.getNameWithPrefix("_ZN7testing8UnitTest3RunEv")),
-  trampoline(new InstrumentationInfo*)
+  fGoogleTestFilterFlag(mangler.getNameWithPrefix("_ZN7testing18FLAGS_gtest_filterE")),
+  trampoline(new InstrumentationInfo*),
+  programStarted(false),
+  programProcess(0)
 {
 }
 
@@ -69,48 +81,97 @@ void GoogleTestRunner::runStaticConstructor(llvm::Function *constructor,
 void GoogleTestRunner::loadInstrumentedProgram(ObjectFiles &objectFiles,
                                                Instrumentation &instrumentation,
                                                JITEngine &jit) {
+  finishProgram();
   InstrumentationResolver resolver(overrides, instrumentation, mangler, trampoline);
   jit.addObjectFiles(objectFiles, resolver, make_unique<SectionMemoryManager>());
+  programProcess = getpid();
 }
 
 void GoogleTestRunner::loadProgram(ObjectFiles &objectFiles, JITEngine &jit) {
+  finishProgram();
   NativeResolver resolver(overrides);
   jit.addObjectFiles(objectFiles, resolver, make_unique<SectionMemoryManager>());
+  programProcess = getpid();
 }
 
-ExecutionStatus GoogleTestRunner::runTest(Test *test, JITEngine &jit) {
-  *trampoline = &test->getInstrumentationInfo();
-
-  GoogleTest_Test *GTest = dyn_cast<GoogleTest_Test>(test);
+/// Normally Google Test Driver looks like this:
+///
+///   int main(int argc, char **argv) {
+///     InitGoogleTest(&argc, argv);
+///     return UnitTest.GetInstance()->Run();
+///   }
+///
+/// Technically we can just call `main` function, but there is a problem:
+/// Among all the files that are being processed may be more than one
+/// `main` function, therefore we can call wrong driver.
+///
+/// To avoid this from happening we implement the driver function on our own.
+/// We must keep in mind that each project can have its own, extended
+/// version of the driver (LLVM itself has one).
+///
+/// All the tests share the same set of static constructors, and running
+/// them twice registers every test twice, so they run once per program
+/// and process, the same goes for InitGoogleTest which parses the command
+/// line only once anyway. The filter of each test is set directly, see
+/// 'filterFlag'.
+void GoogleTestRunner::startProgram(GoogleTest_Test *test, JITEngine &jit) {
+  if (programStarted) {
+    return;
+  }
+  programStarted = true;
 
-  for (auto &Ctor: GTest->GetGlobalCtors()) {
+  for (auto &Ctor: test->GetGlobalCtors()) {
     runStaticConstructor(Ctor, jit);
   }
 
-  std::string filter = "--gtest_filter=" + GTest->getTestName();
+  std::string filter = "--gtest_filter=" + test->getTestName();
   const char *argv[] = { "mull", filter.c_str(), NULL };
   int argc = 2;
 
-  /// Normally Google Test Driver looks like this:
-  ///
-  ///   int main(int argc, char **argv) {
-  ///     InitGoogleTest(&argc, argv);
-  ///     return UnitTest.GetInstance()->Run();
-  ///   }
-  ///
-  /// Technically we can just call `main` function, but there is a problem:
-  /// Among all the files that are being processed may be more than one
-  /// `main` function, therefore we can call wrong driver.
-  ///
-  /// To avoid this from happening we implement the driver function on our own.
-  /// We must keep in mind that each project can have its own, extended
-  /// version of the driver (LLVM itself has one).
-  ///
-
   void *initGTestPtr = getFunctionPointer(fGoogleTestInit, jit);
-
   auto initGTest = ((void (*)(int *, const char**))(intptr_t)initGTestPtr);
   initGTest(&argc, argv);
+}
+
+/// The static objects of a program started in this process are destroyed
+/// before the next program is loaded
+void GoogleTestRunner::finishProgram() {
+  if (programStarted && programProcess == getpid()) {
+    overrides.runDestructors();
+  }
+  programStarted = false;
+}
+
+/// A forked process exits after its tests, while the process that has
+/// loaded the program runs the next tests against the same static objects
+void GoogleTestRunner::finishTests() {
+  if (programProcess != getpid()) {
+    overrides.runDestructors();
+  }
+}
+
+/// InitGoogleTest parses the command line only once per process, hence
+/// for the rest of the tests we change the filter directly:
+///
+///   testing::GTEST_FLAG(filter) = "Suite.Test";
+///
+/// UnitTest::Run re-applies the filter and resets the results of
+/// the previous run on each invocation, the same way '--gtest_repeat' does.
+///
+/// Note: this assumes the program under test is built against the same
+/// C++ standard library as Mull, which is always the case for the JIT.
+std::string *GoogleTestRunner::filterFlag(JITEngine &jit) {
+  void *filterFlagPtr = getFunctionPointer(fGoogleTestFilterFlag, jit);
+  return static_cast<std::string *>(filterFlagPtr);
+}
+
+ExecutionStatus GoogleTestRunner::runTest(Test *test, JITEngine &jit) {
+  Callbacks::setInstrumentationInfo(trampoline, &test->getInstrumentationInfo());
+
+  GoogleTest_Test *GTest = dyn_cast<GoogleTest_Test>(test);
+
+  startProgram(GTest, jit);
+  *filterFlag(jit) = GTest->getTestName();
 
   void *getInstancePtr = getFunctionPointer(fGoogleTestInstance, jit);
 
@@ -122,10 +183,58 @@ ExecutionStatus GoogleTestRunner::runTest(Test *test, JITEngine &jit) {
   auto runAllTests = ((int (*)(UnitTest *))(intptr_t)runAllTestsPtr);
   uint64_t result = runAllTests(unitTest);
 
-  overrides.runDestructors();
+  finishTests();
 
   if (result == 0) {
     return ExecutionStatus::Passed;
   }
   return ExecutionStatus::Failed;
 }
+
+bool GoogleTestRunner::supportsBatchExecution() const {
+  return true;
+}
+
+void GoogleTestRunner::runTests(TestBatch &batch, JITEngine &jit) {
+  GoogleTest_Test *firstTest = dyn_cast<GoogleTest_Test>(batch.getTest(batch.getFirst()));
+  startProgram(firstTest, jit);
+
+  void *getInstancePtr = getFunctionPointer(fGoogleTestInstance, jit);
+  auto getInstance = ((UnitTest *(*)())(intptr_t)getInstancePtr);
+  UnitTest *unitTest = getInstance();
+
+  void *runAllTestsPtr = getFunctionPointer(fGoogleTestRun, jit);
+  auto runAllTests = ((int (*)(UnitTest *))(intptr_t)runAllTestsPtr);
+
+  std::string *filter = filterFlag(jit);
+
+  for (size_t index = batch.getFirst(); index < batch.size(); index++) {
+    GoogleTest_Test *test = dyn_cast<GoogleTest_Test>(batch.getTest(index));
+    Callbacks::setInstrumentationInfo(trampoline, &test->getInstrumentationInfo());
+    *filter = test->getTestName();
+
+    batch.setCurrent(index);
+    ExecutionBudget::arm(batch.getExecutionBudget(index));
+    if (batch.getTimeout(index) != 0) {
+      ForkProcessSandbox::restartTimeout(batch.getTimeout(index));
+    }
+
+    auto start = high_resolution_clock::now();
+    uint64_t result = runAllTests(unitTest);
+    auto elapsed = high_resolution_clock::now() - start;
+
+    ExecutionStatus status = result == 0 ? ExecutionStatus::Passed
+                                         : ExecutionStatus::Failed;
+    batch.setEntry(index, status,
+                   duration_cast<std::chrono::milliseconds>(elapsed).count());
+
+    if (status != ExecutionStatus::Passed && batch.shouldStopAfterFailure()) {
+      batch.setCurrent(index + 1);
+      finishTests();
+      return;
+    }
+  }
+
+  batch.setCurrent(batch.size());
+  finishTests();
+}
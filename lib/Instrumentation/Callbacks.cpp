@@ -5,27 +5,86 @@
 
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/Transforms/Utils/BasicBlockUtils.h>
 
 using namespace mull;
 using namespace llvm;
 
+namespace {
+
+/// The call stack of a thread running instrumented code
+struct ThreadCallStack {
+  InstrumentationInfo *info;
+  std::vector<uint32_t> functions;
+};
+
+}
+
+/// Set on the thread that runs a test, see Callbacks::setInstrumentationInfo.
+/// Threads started by the test do not have it and use the trampoline.
+static thread_local InstrumentationInfo *threadInstrumentationInfo = nullptr;
+static thread_local ThreadCallStack threadCallStack;
+
+static std::vector<uint32_t> &callStackOf(InstrumentationInfo *info) {
+  if (threadCallStack.info != info) {
+    threadCallStack.info = info;
+    threadCallStack.functions.clear();
+  }
+  return threadCallStack.functions;
+}
+
 namespace mull {
 
 extern "C" void mull_enterFunction(void **trampoline, uint32_t functionIndex) {
-  InstrumentationInfo *info = (InstrumentationInfo *)*trampoline;
+  bool testThread = threadInstrumentationInfo != nullptr;
+  InstrumentationInfo *info = testThread ? threadInstrumentationInfo
+                                         : (InstrumentationInfo *)*trampoline;
   assert(info);
   assert(info->callTreeMapping);
-  DynamicCallTree::enterFunction(functionIndex, info->callTreeMapping, info->callstack);
+
+  /// A thread started by the test continues the tree from the function
+  /// the test's thread is currently in
+  uint32_t threadParent = 0;
+  if (!testThread) {
+    threadParent = __atomic_load_n(&info->currentFunction, __ATOMIC_RELAXED);
+  }
+
+  auto &stack = callStackOf(info);
+  DynamicCallTree::enterFunction(functionIndex, info->callTreeMapping, stack, threadParent);
+
+  if (testThread) {
+    __atomic_store_n(&info->currentFunction, functionIndex, __ATOMIC_RELAXED);
+  }
 }
 
 extern "C" void mull_leaveFunction(void **trampoline, uint32_t functionIndex) {
-  InstrumentationInfo *info = (InstrumentationInfo *)*trampoline;
+  bool testThread = threadInstrumentationInfo != nullptr;
+  InstrumentationInfo *info = testThread ? threadInstrumentationInfo
+                                         : (InstrumentationInfo *)*trampoline;
   assert(info);
   assert(info->callTreeMapping);
-  DynamicCallTree::leaveFunction(functionIndex, info->callTreeMapping, info->callstack);
+
+  auto &stack = callStackOf(info);
+  DynamicCallTree::leaveFunction(functionIndex, info->callTreeMapping, stack);
+
+  if (testThread) {
+    uint32_t top = stack.empty() ? 0 : stack.back();
+    __atomic_store_n(&info->currentFunction, top, __ATOMIC_RELAXED);
+  }
+}
+
 }
 
+void Callbacks::setInstrumentationInfo(InstrumentationInfo **trampoline,
+                                       InstrumentationInfo *info) {
+  *trampoline = info;
+  threadInstrumentationInfo = info;
+  threadCallStack.info = info;
+  threadCallStack.functions.clear();
 }
 
 Value *Callbacks::injectInstrumentationInfoPointer(Module *module,
@@ -45,6 +104,209 @@ Value *Callbacks::injectFunctionIndexOffset(Module *module,
   return module->getOrInsertGlobal(functionIndexOffset, functionIndexOffsetType);
 }
 
+Value *Callbacks::injectBlockIndexOffset(Module *module,
+                                         const char *blockIndexOffsetPrefix) {
+  /// Same kind of per-module offset, just counted in basic blocks
+  return injectFunctionIndexOffset(module, blockIndexOffsetPrefix);
+}
+
+/// The fields of InstrumentationInfo accessed by the instrumented code:
+///
+///   struct {
+///     uint32_t *callTreeMapping;
+///     uint8_t *blockCoverage;
+///     uint32_t currentFunction;
+///     uint64_t *callCounts;
+///   };
+///
+static StructType *instrumentationInfoType(LLVMContext &context) {
+  return StructType::get(Type::getInt32Ty(context)->getPointerTo(),
+                         Type::getInt8Ty(context)->getPointerTo(),
+                         Type::getInt32Ty(context),
+                         Type::getInt64Ty(context)->getPointerTo());
+}
+
+enum InstrumentationInfoField {
+  CallTreeMappingField = 0,
+  BlockCoverageField = 1,
+  CurrentFunctionField = 2,
+  CallCountsField = 3
+};
+
+/// Loads the 'InstrumentationInfo *' the trampoline points to
+static Value *loadInstrumentationInfo(IRBuilder<> &builder, Value *infoPointer) {
+  auto infoType = instrumentationInfoType(builder.getContext());
+  auto trampolineType = infoType->getPointerTo()->getPointerTo();
+  auto trampoline = builder.CreateBitCast(infoPointer, trampolineType);
+  return builder.CreateLoad(trampoline, "info");
+}
+
+Instruction *Callbacks::firstInstructionAfterAllocas(BasicBlock &entryBlock) {
+  Instruction *instruction = &*entryBlock.getFirstInsertionPt();
+  for (auto &candidate : entryBlock) {
+    if (isa<AllocaInst>(candidate)) {
+      instruction = candidate.getNextNode();
+    }
+  }
+  return instruction;
+}
+
+/// A function that does not call anything is never a parent
+/// in the call tree
+static bool isLeafFunction(Function &function) {
+  for (auto &block : function) {
+    for (auto &instruction : block) {
+      if (isa<InvokeInst>(instruction)) {
+        return false;
+      }
+      if (isa<CallInst>(instruction) && !isa<IntrinsicInst>(instruction)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void Callbacks::injectBlockCoverage(llvm::Function *function,
+                                    uint32_t firstBlockIndex,
+                                    Value *infoPointer,
+                                    Value *blockOffset) {
+  auto &context = function->getParent()->getContext();
+  auto byteType = Type::getInt8Ty(context);
+  auto intType = Type::getInt32Ty(context);
+  auto infoType = instrumentationInfoType(context);
+
+  /// Collecting the blocks first: the order must match the one used by
+  /// Instrumentation::recordFunctions
+  std::vector<BasicBlock *> blocks;
+  for (auto &block : function->getBasicBlockList()) {
+    blocks.push_back(&block);
+  }
+
+  /// Computing the address of the function's first block once, on entry:
+  ///
+  ///   uint8_t *coverage = (*trampoline)->blockCoverage
+  ///                       + blockOffset + firstBlockIndex;
+  ///
+  auto &entryBlock = function->getEntryBlock();
+  IRBuilder<> builder(&entryBlock, entryBlock.getFirstInsertionPt());
+
+  auto info = loadInstrumentationInfo(builder, infoPointer);
+  auto coverageField = builder.CreateStructGEP(infoType, info, BlockCoverageField);
+  auto coverage = builder.CreateLoad(coverageField, "blockCoverage");
+  auto index = builder.CreateAdd(builder.CreateLoad(blockOffset, "blockOffset"),
+                                 ConstantInt::get(intType, firstBlockIndex));
+  auto functionCoverage = builder.CreateGEP(coverage, index, "functionCoverage");
+
+  /// Then each block stores one byte: coverage[i] = 1;
+  /// The entry block is the first one, its store goes right after the above.
+  auto executed = ConstantInt::get(byteType, 1);
+  for (uint32_t i = 0; i < blocks.size(); i++) {
+    auto block = blocks[i];
+    if (block != &entryBlock) {
+      auto insertionPoint = block->getFirstInsertionPt();
+      /// E.g. 'catchswitch' blocks cannot contain anything else
+      if (insertionPoint == block->end()) {
+        continue;
+      }
+      builder.SetInsertPoint(block, insertionPoint);
+    }
+    builder.CreateStore(executed, builder.CreateConstGEP1_32(functionCoverage, i));
+  }
+}
+
+void Callbacks::injectCallCounter(llvm::Function *function,
+                                  uint32_t index,
+                                  Value *infoPointer,
+                                  Value *offset) {
+  auto &context = function->getParent()->getContext();
+  auto intType = Type::getInt32Ty(context);
+  auto infoType = instrumentationInfoType(context);
+
+  /// (*trampoline)->callCounts[offset + index] += 1;
+  ///
+  /// Not atomic: the threads started by a test may lose a few calls,
+  /// the counts are only used as an estimate
+  IRBuilder<> builder(firstInstructionAfterAllocas(function->getEntryBlock()));
+
+  auto info = loadInstrumentationInfo(builder, infoPointer);
+  auto countsField = builder.CreateStructGEP(infoType, info, CallCountsField);
+  auto counts = builder.CreateLoad(countsField, "callCounts");
+  auto functionIndex = builder.CreateAdd(builder.CreateLoad(offset, "offset"),
+                                         ConstantInt::get(intType, index));
+  auto slot = builder.CreateGEP(counts, functionIndex);
+  auto count = builder.CreateAdd(builder.CreateLoad(slot, "callCount"),
+                                 builder.getInt64(1));
+  builder.CreateStore(count, slot);
+}
+
+void Callbacks::injectInlineCallTree(llvm::Function *function,
+                                     uint32_t index,
+                                     Value *infoPointer,
+                                     Value *offset) {
+  auto &context = function->getParent()->getContext();
+  auto intType = Type::getInt32Ty(context);
+  auto infoType = instrumentationInfoType(context);
+  auto zero = ConstantInt::get(intType, 0);
+
+  /// Collecting the returns before the entry block is split
+  std::vector<ReturnInst *> returns;
+  for (auto &block : function->getBasicBlockList()) {
+    if (auto returnStatement = dyn_cast<ReturnInst>(block.getTerminator())) {
+      returns.push_back(returnStatement);
+    }
+  }
+
+  /// The same as DynamicCallTree::enterFunction, with the top of the stack
+  /// kept in 'currentFunction' and the rest of the stack kept in registers:
+  ///
+  ///   uint32_t parent = info->currentFunction;
+  ///   uint32_t functionIndex = offset + index;
+  ///   if (parent == 0 || info->callTreeMapping[functionIndex] == 0) {
+  ///     info->callTreeMapping[functionIndex] = parent == 0 ? functionIndex : parent;
+  ///   }
+  ///   info->currentFunction = functionIndex;
+  ///   ...
+  ///   info->currentFunction = parent;
+  ///   return;
+  ///
+  Instruction *entryPoint = firstInstructionAfterAllocas(function->getEntryBlock());
+  IRBuilder<> builder(entryPoint);
+
+  auto info = loadInstrumentationInfo(builder, infoPointer);
+  auto mappingField = builder.CreateStructGEP(infoType, info, CallTreeMappingField);
+  auto mapping = builder.CreateLoad(mappingField, "callTreeMapping");
+  auto currentFunction = builder.CreateStructGEP(infoType, info, CurrentFunctionField);
+  auto parent = builder.CreateLoad(currentFunction, "parent");
+  auto functionIndex = builder.CreateAdd(builder.CreateLoad(offset, "offset"),
+                                         ConstantInt::get(intType, index),
+                                         "functionIndex");
+  auto slot = builder.CreateGEP(mapping, functionIndex);
+  auto isRoot = builder.CreateICmpEQ(parent, zero);
+  auto isFirstCall = builder.CreateICmpEQ(builder.CreateLoad(slot), zero);
+  auto shouldRecord = builder.CreateOr(isRoot, isFirstCall);
+
+  /// Only the first call of a function is recorded
+  MDNode *weights = MDBuilder(context).createBranchWeights(1, 1 << 10);
+  auto recordTerminator = SplitBlockAndInsertIfThen(shouldRecord, entryPoint, false, weights);
+  IRBuilder<> recordBuilder(recordTerminator);
+  recordBuilder.CreateStore(recordBuilder.CreateSelect(isRoot, functionIndex, parent), slot);
+
+  /// Nobody sees the current function of a leaf function,
+  /// hence the leave path is not needed either
+  if (isLeafFunction(*function)) {
+    return;
+  }
+
+  builder.SetInsertPoint(entryPoint);
+  builder.CreateStore(functionIndex, currentFunction);
+
+  for (auto returnStatement : returns) {
+    builder.SetInsertPoint(returnStatement);
+    builder.CreateStore(parent, currentFunction);
+  }
+}
+
 void Callbacks::injectCallbacks(llvm::Function *function,
                                 uint32_t index,
                                 Value *infoPointer,
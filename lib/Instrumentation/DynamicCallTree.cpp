@@ -2,26 +2,34 @@
 #include "Test.h"
 #include "Testee.h"
 
+#include <algorithm>
 #include <queue>
 #include <stack>
 
 using namespace mull;
 using namespace llvm;
 
-void DynamicCallTree::enterFunction(const uint32_t functionIndex,
-                                    uint32_t *mapping,
-                                    std::stack<uint32_t> &stack) {
-
-  if (stack.empty()) {
+/// The mapping is shared by all the threads of a test, hence atomics
+static void recordCall(const uint32_t functionIndex,
+                       uint32_t *mapping,
+                       uint32_t parent) {
+  if (parent == 0) {
     /// This is the first function in a chain
     /// The root of a tree
-    mapping[functionIndex] = functionIndex;
-  } else if (mapping[functionIndex] == 0) {
-    /// This function has never been called
-    uint32_t parent = stack.top();
-    mapping[functionIndex] = parent;
+    __atomic_store_n(&mapping[functionIndex], functionIndex, __ATOMIC_RELAXED);
+    return;
   }
 
+  /// Only the first caller is recorded: the function has never been called
+  uint32_t neverCalled = 0;
+  __atomic_compare_exchange_n(&mapping[functionIndex], &neverCalled, parent,
+                              false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+void DynamicCallTree::enterFunction(const uint32_t functionIndex,
+                                    uint32_t *mapping,
+                                    std::stack<uint32_t> &stack) {
+  recordCall(functionIndex, mapping, stack.empty() ? 0 : stack.top());
   stack.push(functionIndex);
 }
 
@@ -31,6 +39,23 @@ void DynamicCallTree::leaveFunction(const uint32_t functionIndex,
   stack.pop();
 }
 
+void DynamicCallTree::enterFunction(const uint32_t functionIndex,
+                                    uint32_t *mapping,
+                                    std::vector<uint32_t> &stack,
+                                    uint32_t threadParent) {
+  recordCall(functionIndex, mapping, stack.empty() ? threadParent : stack.back());
+  stack.push_back(functionIndex);
+}
+
+void DynamicCallTree::leaveFunction(const uint32_t functionIndex,
+                                    uint32_t *mapping,
+                                    std::vector<uint32_t> &stack) {
+  /// Unwinding skips the leave callbacks, the stack may be shorter
+  if (!stack.empty()) {
+    stack.pop_back();
+  }
+}
+
 void fillInCallTree(std::vector<CallTreeFunction> &functions,
                     uint32_t *callTreeMapping, uint32_t functionIndex) {
   assert(functionIndex < functions.size());
@@ -155,3 +180,104 @@ DynamicCallTree::createTestees(std::vector<CallTree *> subtrees,
 
   return testees;
 }
+
+#pragma mark - CallForest
+
+CallForest::CallForest()
+    : mapping(nullptr), functionsCount(0), firstChild(), children(), queue() {}
+
+void CallForest::build(const uint32_t *mapping, size_t functionsCount) {
+  assert(mapping != nullptr);
+  assert(mapping[0] == 0);
+  assert(functionsCount > 0);
+
+  this->mapping = mapping;
+  this->functionsCount = functionsCount;
+
+  /// Counting sort of the called functions by their parents:
+  /// first 'firstChild[N]' counts the children of N, then it is turned into
+  /// the end of N's children, and is moved back to the beginning while the
+  /// children are placed.
+  firstChild.assign(functionsCount + 1, 0);
+
+  uint32_t calledFunctions = 0;
+  for (uint32_t index = 1; index < functionsCount; index++) {
+    uint32_t parent = mapping[index];
+    if (parent == 0) {
+      continue;
+    }
+    assert(parent < functionsCount);
+    if (parent == index) {
+      parent = 0;
+    }
+    firstChild[parent]++;
+    calledFunctions++;
+  }
+
+  uint32_t end = 0;
+  for (size_t index = 0; index <= functionsCount; index++) {
+    end += firstChild[index];
+    firstChild[index] = end;
+  }
+
+  children.resize(calledFunctions);
+  /// Going backwards keeps the children sorted by their index
+  for (uint32_t index = functionsCount - 1; index > 0; index--) {
+    uint32_t parent = mapping[index];
+    if (parent == 0) {
+      continue;
+    }
+    if (parent == index) {
+      parent = 0;
+    }
+    children[--firstChild[parent]] = index;
+  }
+}
+
+const std::vector<uint32_t> &CallForest::calledFunctions() const {
+  return children;
+}
+
+std::vector<std::unique_ptr<Testee>>
+CallForest::createTestees(const std::vector<CallTreeFunction> &functions,
+                          Test *test, int maxDistance, Filter &filter) {
+  assert(mapping != nullptr && "The forest must be built first");
+  assert(functions.size() == functionsCount);
+
+  std::vector<std::unique_ptr<Testee>> testees;
+
+  std::vector<Function *> entryPoints = test->entryPoints();
+  std::sort(entryPoints.begin(), entryPoints.end());
+
+  for (uint32_t root = 1; root < functionsCount; root++) {
+    if (mapping[root] == 0) {
+      continue;
+    }
+    if (!std::binary_search(entryPoints.begin(), entryPoints.end(),
+                            functions[root].function)) {
+      continue;
+    }
+
+    queue.clear();
+    queue.emplace_back(root, 0);
+    for (size_t head = 0; head < queue.size(); head++) {
+      uint32_t index = queue[head].first;
+      int distance = queue[head].second;
+      Function *function = functions[index].function;
+
+      if (filter.shouldSkipFunction(function)) {
+        continue;
+      }
+
+      testees.push_back(make_unique<Testee>(function, test, distance));
+      if (distance < maxDistance) {
+        for (uint32_t child = firstChild[index]; child < firstChild[index + 1];
+             child++) {
+          queue.emplace_back(children[child], distance + 1);
+        }
+      }
+    }
+  }
+
+  return testees;
+}
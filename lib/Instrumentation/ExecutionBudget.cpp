@@ -0,0 +1,129 @@
+#include "Instrumentation/ExecutionBudget.h"
+#include "Instrumentation/Callbacks.h"
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/CFG.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Transforms/Utils/BasicBlockUtils.h>
+
+#include <algorithm>
+#include <csignal>
+#include <limits>
+
+using namespace mull;
+using namespace llvm;
+
+namespace mull {
+
+extern "C" {
+uint64_t mull_execution_budget_counter = 0;
+uint64_t mull_execution_budget_limit = std::numeric_limits<uint64_t>::max();
+}
+
+/// Both ForkProcessSandbox and InProcessSandbox treat SIGALRM as a timeout
+extern "C" void mull_executionBudgetExceeded() {
+  raise(SIGALRM);
+}
+
+}
+
+const uint64_t ExecutionBudget::MinimalLimit;
+
+static const char *counterName = "mull_execution_budget_counter";
+static const char *limitName = "mull_execution_budget_limit";
+static const char *exceededFunctionName = "mull_executionBudgetExceeded";
+
+/// Inserts the following code right before the 'instruction':
+///
+///   mull_execution_budget_counter++;
+///   if (mull_execution_budget_counter > mull_execution_budget_limit) {
+///     mull_executionBudgetExceeded();
+///   }
+///
+static void insertCounter(Instruction *instruction) {
+  Module *module = instruction->getModule();
+  auto &context = module->getContext();
+  auto counterType = Type::getInt64Ty(context);
+
+  Value *counter = module->getOrInsertGlobal(counterName, counterType);
+  Value *limit = module->getOrInsertGlobal(limitName, counterType);
+  auto exceededType = FunctionType::get(Type::getVoidTy(context), false);
+  Value *exceeded = module->getOrInsertFunction(exceededFunctionName, exceededType);
+
+  IRBuilder<> builder(instruction);
+  Value *steps = builder.CreateAdd(builder.CreateLoad(counter),
+                                   ConstantInt::get(counterType, 1));
+  builder.CreateStore(steps, counter);
+  Value *isExceeded = builder.CreateICmpUGT(steps, builder.CreateLoad(limit));
+
+  MDNode *weights = MDBuilder(context).createBranchWeights(1, 1 << 20);
+  auto terminator = SplitBlockAndInsertIfThen(isExceeded, instruction, true, weights);
+  CallInst::Create(exceeded, "", terminator);
+}
+
+void ExecutionBudget::insertCounters(llvm::Function *function) {
+  SmallVector<std::pair<const BasicBlock *, const BasicBlock *>, 16> backEdges;
+  FindFunctionBackedges(*function, backEdges);
+
+  /// Collecting the insertion points first: inserting a counter splits
+  /// the block and invalidates the back edges
+  std::vector<Instruction *> insertionPoints;
+  for (auto &edge : backEdges) {
+    auto source = const_cast<BasicBlock *>(edge.first);
+    insertionPoints.push_back(source->getTerminator());
+  }
+
+  /// The counter on the entry goes after the allocas: splitting them off
+  /// the entry block would turn them into dynamic allocas
+  insertionPoints.push_back(
+      Callbacks::firstInstructionAfterAllocas(function->getEntryBlock()));
+
+  std::sort(insertionPoints.begin(), insertionPoints.end());
+  insertionPoints.erase(std::unique(insertionPoints.begin(), insertionPoints.end()),
+                        insertionPoints.end());
+
+  for (auto instruction : insertionPoints) {
+    insertCounter(instruction);
+  }
+}
+
+void ExecutionBudget::insertCounters(llvm::Module *module) {
+  std::vector<Function *> functions;
+  for (auto &function : module->getFunctionList()) {
+    if (function.isDeclaration()) {
+      continue;
+    }
+    functions.push_back(&function);
+  }
+
+  for (auto function : functions) {
+    insertCounters(function);
+  }
+}
+
+void ExecutionBudget::arm(uint64_t limit) {
+  mull_execution_budget_counter = 0;
+  if (limit == 0) {
+    mull_execution_budget_limit = std::numeric_limits<uint64_t>::max();
+  } else {
+    mull_execution_budget_limit = limit;
+  }
+}
+
+uint64_t ExecutionBudget::steps() {
+  return mull_execution_budget_counter;
+}
+
+uint64_t ExecutionBudget::limitFor(uint64_t originalSteps, int multiplier) {
+  const uint64_t factor = static_cast<uint64_t>(std::max(multiplier, 0));
+  if (factor != 0 &&
+      originalSteps > std::numeric_limits<uint64_t>::max() / factor) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  return std::max(originalSteps * factor, MinimalLimit);
+}
@@ -5,22 +5,34 @@
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
 
+#include <algorithm>
+
 #include <sys/mman.h>
 #include <sys/types.h>
 
 using namespace mull;
 using namespace llvm;
 
-Instrumentation::Instrumentation()
-: callbacks(), functions() {
+Instrumentation::Instrumentation(bool blockCoverage, bool inlineCallTree,
+                                 bool callCounts)
+: callbacks(), functions(), blockCoverage(blockCoverage),
+  inlineCallTree(inlineCallTree), callCounts(callCounts), blocks() {
   CallTreeFunction phonyRoot(nullptr);
   functions.push_back(phonyRoot);
 }
 
+const std::vector<CallTreeFunction> &Instrumentation::getFunctions() const {
+  return functions;
+}
+
 std::map<std::string, uint32_t> &Instrumentation::getFunctionOffsetMapping() {
   return functionOffsetMapping;
 }
 
+std::map<std::string, uint32_t> &Instrumentation::getBlockOffsetMapping() {
+  return blockOffsetMapping;
+}
+
 const char *Instrumentation::instrumentationInfoVariableName() {
   return "mull_instrumentation_info";
 }
@@ -29,9 +41,14 @@ const char *Instrumentation::functionIndexOffsetPrefix() {
   return "mull_function_index_offset_";
 }
 
+const char *Instrumentation::blockIndexOffsetPrefix() {
+  return "mull_block_index_offset_";
+}
+
 void Instrumentation::recordFunctions(llvm::Module *originalModule) {
   uint32_t offset = functions.size();
   functionOffsetMapping[originalModule->getModuleIdentifier()] = offset;
+  blockOffsetMapping[originalModule->getModuleIdentifier()] = blocks.size();
 
   for (auto &function: originalModule->getFunctionList()) {
     if (function.isDeclaration()) {
@@ -39,34 +56,113 @@ void Instrumentation::recordFunctions(llvm::Module *originalModule) {
     }
     CallTreeFunction callTreeFunction(&function);
     functions.push_back(callTreeFunction);
+
+    for (auto &block : function.getBasicBlockList()) {
+      blocks.push_back(&block);
+    }
+  }
+}
+
+void Instrumentation::instrumentOnly(const std::unordered_set<Function *> &reachable) {
+  instrumentedFunctions.assign(functions.size(), false);
+  for (size_t index = 1; index < functions.size(); index++) {
+    instrumentedFunctions[index] = reachable.count(functions[index].function) != 0;
   }
 }
 
+bool Instrumentation::instrumentsAllFunctions() const {
+  return instrumentedFunctions.empty();
+}
+
 void Instrumentation::insertCallbacks(llvm::Module *instrumentedModule) {
   auto info = callbacks.injectInstrumentationInfoPointer(instrumentedModule,
                                                          instrumentationInfoVariableName());
   auto offset = callbacks.injectFunctionIndexOffset(instrumentedModule,
                                                     functionIndexOffsetPrefix());
 
+  Value *blockOffset = nullptr;
+  if (blockCoverage) {
+    blockOffset = callbacks.injectBlockIndexOffset(instrumentedModule,
+                                                   blockIndexOffsetPrefix());
+  }
+
+  /// The modules are cloned from the files, the identifiers stay the same
+  uint32_t functionOffset = 0;
+  if (!instrumentsAllFunctions()) {
+    functionOffset = functionOffsetMapping.at(instrumentedModule->getModuleIdentifier());
+  }
+
   uint32_t index = 0;
+  uint32_t blockIndex = 0;
   for (auto &function: instrumentedModule->getFunctionList()) {
     if (function.isDeclaration()) {
       continue;
     }
-    callbacks.injectCallbacks(&function, index, info, offset);
+    /// Counting the blocks before any callbacks are inserted
+    uint32_t blocksCount = function.getBasicBlockList().size();
+    if (blockCoverage) {
+      callbacks.injectBlockCoverage(&function, blockIndex, info, blockOffset);
+    }
+    if (!instrumentsAllFunctions() &&
+        !instrumentedFunctions[functionOffset + index]) {
+      /// Not reachable from any test, keeps its index anyway
+    } else {
+      if (callCounts) {
+        callbacks.injectCallCounter(&function, index, info, offset);
+      }
+      if (inlineCallTree) {
+        callbacks.injectInlineCallTree(&function, index, info, offset);
+      } else {
+        callbacks.injectCallbacks(&function, index, info, offset);
+      }
+    }
     index++;
+    blockIndex += blocksCount;
   }
 }
 
 std::vector<std::unique_ptr<Testee>>
-Instrumentation::getTestees(Test *test, Filter &filter, int distance) {
+Instrumentation::getTestees(Test *test, Filter &filter, int distance,
+                            CallForest &forest) {
   auto &mapping = test->getInstrumentationInfo().callTreeMapping;
 
-  auto callTree = DynamicCallTree::createCallTree(mapping, functions);
-  auto subtrees = DynamicCallTree::extractTestSubtrees(callTree.get(), test);
-  auto testees = DynamicCallTree::createTestees(subtrees, test, distance, filter);
+  forest.build(mapping, functions.size());
+  return forest.createTestees(functions, test, distance, filter);
+}
+
+std::vector<uint32_t> Instrumentation::recordCoveredBlocks(Test *test) {
+  std::vector<uint32_t> indices;
+  auto coverage = test->getInstrumentationInfo().blockCoverage;
+  if (coverage == nullptr) {
+    return indices;
+  }
+
+  std::vector<llvm::BasicBlock *> coveredBlocks;
+  for (uint32_t index = 0; index < blocks.size(); index++) {
+    if (coverage[index]) {
+      coveredBlocks.push_back(blocks[index]);
+      indices.push_back(index);
+    }
+  }
+
+  std::sort(coveredBlocks.begin(), coveredBlocks.end());
+  test->setCoveredBlocks(std::move(coveredBlocks));
+  return indices;
+}
+
+void Instrumentation::recordCallCounts(Test *test, const CallForest &forest) {
+  auto counts = test->getInstrumentationInfo().callCounts;
+  if (counts == nullptr) {
+    return;
+  }
+
+  std::vector<std::pair<llvm::Function *, uint64_t>> callCounts;
+  for (uint32_t index : forest.calledFunctions()) {
+    callCounts.emplace_back(functions[index].function, counts[index]);
+  }
 
-  return testees;
+  std::sort(callCounts.begin(), callCounts.end());
+  test->setCallCounts(std::move(callCounts));
 }
 
 void Instrumentation::setupInstrumentationInfo(Test *test) {
@@ -83,10 +179,69 @@ void Instrumentation::setupInstrumentationInfo(Test *test) {
                         -1, 0);
   mapping = static_cast<uint32_t *>(rawMemory);
   memset(mapping, 0, mappingSize);
+
+  if (blockCoverage && !blocks.empty()) {
+    auto &coverage = test->getInstrumentationInfo().blockCoverage;
+    assert(coverage == nullptr && "Called twice?");
+    auto rawCoverage = mmap(NULL, blocks.size(),
+                            PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS,
+                            -1, 0);
+    coverage = static_cast<uint8_t *>(rawCoverage);
+  }
+
+  if (callCounts) {
+    auto &counts = test->getInstrumentationInfo().callCounts;
+    assert(counts == nullptr && "Called twice?");
+    auto rawCounts = mmap(NULL, sizeof(counts[0]) * functions.size(),
+                          PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_ANONYMOUS,
+                          -1, 0);
+    counts = static_cast<uint64_t *>(rawCounts);
+  }
 }
 
 void Instrumentation::cleanupInstrumentationInfo(Test *test) {
-  std::stack<uint32_t>().swap(test->getInstrumentationInfo().callstack);
-  munmap(test->getInstrumentationInfo().callTreeMapping, functions.size());
+  auto &mapping = test->getInstrumentationInfo().callTreeMapping;
+  test->getInstrumentationInfo().currentFunction = 0;
+  munmap(mapping, sizeof(mapping[0]) * functions.size());
+  mapping = nullptr;
+
+  auto &coverage = test->getInstrumentationInfo().blockCoverage;
+  if (coverage != nullptr) {
+    munmap(coverage, blocks.size());
+    coverage = nullptr;
+  }
+
+  auto &counts = test->getInstrumentationInfo().callCounts;
+  if (counts != nullptr) {
+    munmap(counts, sizeof(counts[0]) * functions.size());
+    counts = nullptr;
+  }
 }
 
+std::unique_ptr<InstrumentationBuffers> Instrumentation::createBuffers() {
+  assert(functions.size() > 1 && "Functions must be filled in before this call");
+  size_t blocksCount = blockCoverage ? blocks.size() : 0;
+  return make_unique<InstrumentationBuffers>(functions.size(), blocksCount,
+                                             callCounts);
+}
+
+void Instrumentation::setupInstrumentationInfo(Test *test,
+                                               InstrumentationBuffers &buffers) {
+  auto &info = test->getInstrumentationInfo();
+  assert(info.callTreeMapping == nullptr && "Called twice?");
+  info.callTreeMapping = buffers.getCallTreeMapping();
+  info.blockCoverage = buffers.getBlockCoverage();
+  info.callCounts = buffers.getCallCounts();
+}
+
+void Instrumentation::cleanupInstrumentationInfo(Test *test,
+                                                 InstrumentationBuffers &buffers) {
+  auto &info = test->getInstrumentationInfo();
+  info.currentFunction = 0;
+  info.callTreeMapping = nullptr;
+  info.blockCoverage = nullptr;
+  info.callCounts = nullptr;
+  buffers.reset();
+}
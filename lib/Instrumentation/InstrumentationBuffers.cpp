@@ -0,0 +1,124 @@
+#include "Instrumentation/InstrumentationBuffers.h"
+#include "Logger.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+using namespace mull;
+
+static void *mapSharedMemory(size_t size) {
+  /// Creating a memory to be shared between child and parent.
+  /// Anonymous mappings are zero-filled.
+  void *memory = mmap(nullptr, size,
+                      PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS,
+                      -1, 0);
+  if (memory == MAP_FAILED) {
+    Logger::error() << "Cannot map " << size
+                    << " bytes for the instrumentation: " << strerror(errno)
+                    << "\n";
+    Logger::error() << "Shutting down\n";
+    exit(1);
+  }
+  return memory;
+}
+
+/// The pages of a shared mapping keep their data when they are swapped out,
+/// so all of them are cleared. Removing the pages gives them back to the
+/// system, they read as zeroes afterwards, and untouched pages cost nothing.
+static void clearSharedMemory(void *memory, size_t size) {
+#if defined(MADV_REMOVE)
+  if (madvise(memory, size, MADV_REMOVE) == 0) {
+    return;
+  }
+#endif
+  memset(memory, 0, size);
+}
+
+InstrumentationBuffers::InstrumentationBuffers(size_t functionsCount,
+                                               size_t blocksCount,
+                                               bool callCounts)
+    : functionsCount(functionsCount), blocksCount(blocksCount),
+      callTreeMapping(nullptr), blockCoverage(nullptr), callCounts(nullptr),
+      touchedFunctions(), touchedFunctionsKnown(false),
+      touchedBlocks(), touchedBlocksKnown(false) {
+  callTreeMapping = static_cast<uint32_t *>(
+      mapSharedMemory(sizeof(callTreeMapping[0]) * functionsCount));
+  if (blocksCount != 0) {
+    blockCoverage = static_cast<uint8_t *>(mapSharedMemory(blocksCount));
+  }
+  if (callCounts) {
+    this->callCounts = static_cast<uint64_t *>(
+        mapSharedMemory(sizeof(this->callCounts[0]) * functionsCount));
+  }
+}
+
+InstrumentationBuffers::~InstrumentationBuffers() {
+  munmap(callTreeMapping, sizeof(callTreeMapping[0]) * functionsCount);
+  if (blockCoverage != nullptr) {
+    munmap(blockCoverage, blocksCount);
+  }
+  if (callCounts != nullptr) {
+    munmap(callCounts, sizeof(callCounts[0]) * functionsCount);
+  }
+}
+
+uint32_t *InstrumentationBuffers::getCallTreeMapping() const {
+  return callTreeMapping;
+}
+
+uint8_t *InstrumentationBuffers::getBlockCoverage() const {
+  return blockCoverage;
+}
+
+uint64_t *InstrumentationBuffers::getCallCounts() const {
+  return callCounts;
+}
+
+void InstrumentationBuffers::setTouchedFunctions(const std::vector<uint32_t> &indices) {
+  touchedFunctions.assign(indices.begin(), indices.end());
+  touchedFunctionsKnown = true;
+}
+
+void InstrumentationBuffers::setTouchedBlocks(const std::vector<uint32_t> &indices) {
+  touchedBlocks.assign(indices.begin(), indices.end());
+  touchedBlocksKnown = true;
+}
+
+void InstrumentationBuffers::reset() {
+  /// A function is counted only when it is in the call tree as well
+  if (touchedFunctionsKnown) {
+    for (uint32_t index : touchedFunctions) {
+      callTreeMapping[index] = 0;
+      if (callCounts != nullptr) {
+        callCounts[index] = 0;
+      }
+    }
+  } else {
+    clearSharedMemory(callTreeMapping, sizeof(callTreeMapping[0]) * functionsCount);
+    if (callCounts != nullptr) {
+      clearSharedMemory(callCounts, sizeof(callCounts[0]) * functionsCount);
+    }
+  }
+
+  if (blockCoverage != nullptr) {
+    if (touchedBlocksKnown) {
+      for (uint32_t index : touchedBlocks) {
+        blockCoverage[index] = 0;
+      }
+    } else {
+      clearSharedMemory(blockCoverage, blocksCount);
+    }
+  }
+
+  /// The next test may write anywhere until told otherwise
+  touchedFunctions.clear();
+  touchedFunctionsKnown = false;
+  touchedBlocks.clear();
+  touchedBlocksKnown = false;
+}
@@ -0,0 +1,363 @@
+#include "Instrumentation/SamplingProfiler.h"
+#include "Logger.h"
+#include "Test.h"
+#include "Toolchain/JITEngine.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Object/SymbolSize.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace mull;
+using namespace llvm;
+using namespace std::chrono;
+
+const uint64_t SamplingProfiler::TargetSamples;
+const int SamplingProfiler::MaxRuns;
+const uint64_t SamplingProfiler::SamplingPeriod;
+
+/// Marks the names of functions that cannot be told apart by the symbol name,
+/// e.g. static functions with the same name in different modules
+static const uint32_t AmbiguousFunction = std::numeric_limits<uint32_t>::max();
+
+/// Call chains mark the switches between the kernel and the user space
+/// with the values starting from this one (PERF_CONTEXT_MAX)
+static const uint64_t FirstContextMarker = static_cast<uint64_t>(-4095);
+
+#if defined(__linux__)
+
+namespace {
+
+/// A task clock counter of the calling thread that samples the user-space
+/// call chains into a ring buffer.
+/// The threads started by the test are not sampled: the kernel does not let
+/// per-task counters inherited by new threads be mapped into memory.
+class CallChainSampler {
+public:
+  /// 2^n pages for the samples plus one page for the header
+  static const size_t DataPages = 64;
+
+  CallChainSampler() : descriptor(-1), buffer(nullptr), bufferSize(0) {
+    perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_SOFTWARE;
+    attributes.config = PERF_COUNT_SW_TASK_CLOCK;
+    attributes.sample_period = SamplingProfiler::SamplingPeriod;
+    attributes.sample_type = PERF_SAMPLE_IP | PERF_SAMPLE_CALLCHAIN;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.exclude_callchain_kernel = 1;
+
+    descriptor = syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+    if (descriptor == -1) {
+      return;
+    }
+
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    bufferSize = (DataPages + 1) * pageSize;
+    void *rawMemory = mmap(nullptr, bufferSize, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, descriptor, 0);
+    if (rawMemory == MAP_FAILED) {
+      close(descriptor);
+      descriptor = -1;
+      return;
+    }
+    buffer = static_cast<char *>(rawMemory);
+    data = buffer + pageSize;
+    dataSize = DataPages * pageSize;
+  }
+
+  ~CallChainSampler() {
+    if (buffer) {
+      munmap(buffer, bufferSize);
+    }
+    if (descriptor != -1) {
+      close(descriptor);
+    }
+  }
+
+  CallChainSampler(const CallChainSampler &) = delete;
+  CallChainSampler &operator=(const CallChainSampler &) = delete;
+
+  bool isOpen() const {
+    return descriptor != -1;
+  }
+
+  void enable() {
+    ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+  }
+
+  void disable() {
+    ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+  }
+
+  /// Calls 'consume(addresses, count)' for each sample in the buffer and
+  /// empties the buffer. Returns the number of samples.
+  template <typename Consumer>
+  uint64_t drain(Consumer consume) {
+    auto header = reinterpret_cast<perf_event_mmap_page *>(buffer);
+    uint64_t head = __atomic_load_n(&header->data_head, __ATOMIC_ACQUIRE);
+    uint64_t tail = header->data_tail;
+    uint64_t samples = 0;
+
+    while (tail + sizeof(perf_event_header) <= head) {
+      perf_event_header recordHeader;
+      copy(tail, &recordHeader, sizeof(recordHeader));
+      if (recordHeader.size < sizeof(recordHeader)) {
+        break;
+      }
+
+      /// header; u64 ip; u64 nr; u64 ips[nr];
+      if (recordHeader.type == PERF_RECORD_SAMPLE &&
+          recordHeader.size >= 3 * sizeof(uint64_t)) {
+        record.resize(recordHeader.size / sizeof(uint64_t));
+        copy(tail, record.data(), recordHeader.size);
+        const uint64_t *body = record.data() +
+                               sizeof(recordHeader) / sizeof(uint64_t);
+        uint64_t count = std::min<uint64_t>(body[1], record.size() - 3);
+        consume(body + 2, count);
+        samples++;
+      }
+
+      tail += recordHeader.size;
+    }
+
+    __atomic_store_n(&header->data_tail, tail, __ATOMIC_RELEASE);
+    return samples;
+  }
+
+private:
+  /// Records may wrap around the end of the buffer
+  void copy(uint64_t offset, void *destination, size_t size) {
+    size_t begin = offset % dataSize;
+    size_t firstPart = std::min(size, dataSize - begin);
+    memcpy(destination, data + begin, firstPart);
+    memcpy(static_cast<char *>(destination) + firstPart, data, size - firstPart);
+  }
+
+  int descriptor;
+  char *buffer;
+  size_t bufferSize;
+  char *data;
+  size_t dataSize;
+  std::vector<uint64_t> record;
+};
+
+}
+
+bool SamplingProfiler::isSupported() {
+  CallChainSampler sampler;
+  return sampler.isOpen();
+}
+
+#else
+
+bool SamplingProfiler::isSupported() {
+  return false;
+}
+
+#endif
+
+void SamplingProfiler::keepFramePointers(llvm::Module *module) {
+  for (auto &function : module->getFunctionList()) {
+    if (function.isDeclaration()) {
+      continue;
+    }
+    function.addFnAttr("no-frame-pointer-elim", "true");
+    function.addFnAttr("no-frame-pointer-elim-non-leaf");
+  }
+}
+
+std::shared_ptr<SamplingStatistics> SamplingProfiler::createStatistics() {
+  /// Creating a memory to be shared between child and parent.
+  auto rawMemory = mmap(nullptr, sizeof(SamplingStatistics),
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS,
+                        -1, 0);
+  auto statistics = static_cast<SamplingStatistics *>(rawMemory);
+  memset(statistics, 0, sizeof(SamplingStatistics));
+  return std::shared_ptr<SamplingStatistics>(statistics, [](SamplingStatistics *memory) {
+    munmap(memory, sizeof(SamplingStatistics));
+  });
+}
+
+SamplingProfiler::SamplingProfiler(const std::vector<CallTreeFunction> &callTreeFunctions,
+                                   JITEngine &jit) {
+  /// Symbol names of the functions, e.g. '_main' for 'main' on macOS
+  StringMap<uint32_t> indices;
+  functions.push_back(nullptr);
+  for (uint32_t index = 1; index < callTreeFunctions.size(); index++) {
+    Function *function = callTreeFunctions[index].function;
+    functions.push_back(function);
+
+    std::string name = function->getName().str();
+    char prefix = function->getParent()->getDataLayout().getGlobalPrefix();
+    if (prefix != '\0') {
+      name.insert(name.begin(), prefix);
+    }
+
+    auto inserted = indices.insert(std::make_pair(name, index));
+    if (!inserted.second) {
+      inserted.first->second = AmbiguousFunction;
+    }
+  }
+
+  for (auto objectFile : jit.getObjectFiles()) {
+    for (auto &symbolAndSize : object::computeSymbolSizes(*objectFile)) {
+      auto &symbol = symbolAndSize.first;
+
+      auto type = symbol.getType();
+      if (!type) {
+        consumeError(type.takeError());
+        continue;
+      }
+      if (type.get() != object::SymbolRef::ST_Function) {
+        continue;
+      }
+
+      auto name = symbol.getName();
+      if (!name) {
+        consumeError(name.takeError());
+        continue;
+      }
+
+      auto index = indices.find(name.get());
+      if (index == indices.end() || index->second == AmbiguousFunction) {
+        continue;
+      }
+
+      llvm_compat::JITSymbol &jitSymbol = jit.getSymbol(name.get());
+      uint64_t address = llvm_compat::JITSymbolAddress(jitSymbol);
+      if (address == 0 || symbolAndSize.second == 0) {
+        continue;
+      }
+
+      ranges.push_back({ address, address + symbolAndSize.second, index->second });
+    }
+  }
+
+  std::sort(ranges.begin(), ranges.end());
+}
+
+uint32_t SamplingProfiler::functionAt(uint64_t address) const {
+  AddressRange key = { address, address, 0 };
+  auto range = std::upper_bound(ranges.begin(), ranges.end(), key);
+  if (range == ranges.begin()) {
+    return 0;
+  }
+  --range;
+  if (address >= range->end) {
+    return 0;
+  }
+  return range->functionIndex;
+}
+
+ExecutionStatus SamplingProfiler::profile(Test *test,
+                                          const std::function<ExecutionStatus()> &run,
+                                          long long timeBudget,
+                                          SamplingStatistics &statistics) const {
+  memset(&statistics, 0, sizeof(statistics));
+
+#if defined(__linux__)
+  CallChainSampler sampler;
+  if (!sampler.isOpen()) {
+    Logger::warn() << "Cannot sample the call stacks of " << test->getTestName()
+                   << ": " << strerror(errno) << "\n";
+  }
+#endif
+
+  uint32_t *mapping = test->getInstrumentationInfo().callTreeMapping;
+
+  std::vector<bool> entryPoints(functions.size(), false);
+  for (auto entryPoint : test->entryPoints()) {
+    auto position = std::find(functions.begin(), functions.end(), entryPoint);
+    if (position != functions.end()) {
+      entryPoints[position - functions.begin()] = true;
+    }
+  }
+
+  std::vector<uint32_t> chain;
+  std::vector<uint32_t> stack;
+  /// Records the part of the call chain that starts at the outermost entry
+  /// point of the test. Other chains, e.g. truncated ones, would make the
+  /// functions they reach look like roots of the call tree.
+  auto recordChain = [&](const uint64_t *addresses, uint64_t count) {
+    chain.clear();
+    bool leaf = true;
+    for (uint64_t i = 0; i < count; i++) {
+      uint64_t address = addresses[i];
+      if (address >= FirstContextMarker) {
+        continue;
+      }
+      /// Return addresses point right after the call instruction,
+      /// which may be the first byte of the next function
+      uint32_t index = functionAt(leaf ? address : address - 1);
+      leaf = false;
+      if (index != 0 && (chain.empty() || chain.back() != index)) {
+        chain.push_back(index);
+      }
+    }
+
+    auto outermost = std::find_if(chain.rbegin(), chain.rend(), [&](uint32_t index) {
+      return entryPoints[index];
+    });
+    stack.clear();
+    for (auto it = outermost; it != chain.rend(); ++it) {
+      DynamicCallTree::enterFunction(*it, mapping, stack, 0);
+    }
+  };
+
+  auto start = steady_clock::now();
+  ExecutionStatus firstStatus = Invalid;
+
+  while (true) {
+    auto runStart = steady_clock::now();
+#if defined(__linux__)
+    if (sampler.isOpen()) {
+      sampler.enable();
+    }
+#endif
+    ExecutionStatus status = run();
+#if defined(__linux__)
+    if (sampler.isOpen()) {
+      sampler.disable();
+      statistics.samples += sampler.drain(recordChain);
+    }
+#endif
+    auto now = steady_clock::now();
+
+    if (statistics.runs == 0) {
+      firstStatus = status;
+      statistics.runningTime = duration_cast<milliseconds>(now - runStart).count();
+    }
+    statistics.runs++;
+
+    long long elapsed = duration_cast<milliseconds>(now - start).count();
+    if (status != Passed ||
+        statistics.samples >= TargetSamples ||
+        statistics.runs >= MaxRuns ||
+        elapsed >= timeBudget) {
+      break;
+    }
+  }
+
+  return firstStatus;
+}
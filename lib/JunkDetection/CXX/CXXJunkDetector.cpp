@@ -12,10 +12,7 @@
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Instruction.h>
 #include <llvm/Support/Path.h>
-#include <llvm/Support/FileSystem.h>
 #include <clang/Tooling/CompilationDatabase.h>
-#include <unistd.h>
-#include <sys/param.h>
 
 using namespace mull;
 using namespace llvm;
@@ -76,33 +73,6 @@ void dump_cursor(CXCursor cursor, CXSourceLocation location, MutationPoint *poin
   delete[] buffer;
 }
 
-#pragma mark - CHDir
-
-class CHDir {
-public:
-  CHDir() {
-    SmallString<MAXPATHLEN> currentPath;
-    auto error = llvm::sys::fs::current_path(currentPath);
-    if (error) {
-      Logger::error() << error.message() << "\n";
-    }
-    prevWorkDir = currentPath.str();
-  }
-  void enter(const std::string &wd) {
-    /// TODO: LLVM-5 and higher has llvm::sys::fs::set_current_path
-    if (chdir(wd.c_str()) == -1) {
-      perror("chdir");
-    }
-  }
-  ~CHDir() {
-    if (chdir(prevWorkDir.c_str()) == -1) {
-      perror("~chdir");
-    }
-  }
-private:
-  std::string prevWorkDir;
-};
-
 #pragma mark - LibClang arguments
 
 struct LibClangArgs {
@@ -177,24 +147,40 @@ static std::vector<std::string> getCompilationFlags(const std::string &flags) {
 }
 
 CXXJunkDetector::CXXJunkDetector(JunkDetectionConfig &config)
-: index(clang_createIndex(true, true)) {
+: indexes(), units() {
   compdb = getCompilationDatabase(config.cxxCompDBDirectory);
   compilationFlags = getCompilationFlags(config.cxxCompilationFlags);
 }
 
 CXXJunkDetector::~CXXJunkDetector() {
   for (auto &pair : units) {
-    clang_disposeTranslationUnit(pair.second);
+    if (pair.second != nullptr) {
+      clang_disposeTranslationUnit(pair.second);
+    }
+  }
+  for (auto &pair : indexes) {
+    clang_disposeIndex(pair.second);
   }
-  clang_disposeIndex(index);
+}
+
+CXIndex CXXJunkDetector::threadIndex() {
+  std::lock_guard<std::mutex> guard(mutex);
+  auto &index = indexes[std::this_thread::get_id()];
+  if (index == nullptr) {
+    index = clang_createIndex(true, true);
+  }
+  return index;
 }
 
 CXTranslationUnit
 CXXJunkDetector::translationUnit(const SourceLocation &location,
                                  const std::string &sourceFile) {
-  std::lock_guard<std::mutex> guard(mutex);
-  if (units.count(sourceFile) != 0) {
-    return units[sourceFile];
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto unit = units.find(sourceFile);
+    if (unit != units.end()) {
+      return unit->second;
+    }
   }
 
   std::vector<std::string> commandLine;
@@ -213,12 +199,14 @@ CXXJunkDetector::translationUnit(const SourceLocation &location,
     commandLine = compilationFlags;
   }
 
-  CHDir changeDir;
-  changeDir.enter(directory);
+  /// Changing the current directory would affect all the threads
+  if (!directory.empty()) {
+    commandLine.insert(commandLine.begin(), { "-working-directory", directory });
+  }
   LibClangArgs args = getLibClangArgs(commandLine);
 
   CXTranslationUnit unit = nullptr;
-  CXErrorCode code = clang_parseTranslationUnit2(index,
+  CXErrorCode code = clang_parseTranslationUnit2(threadIndex(),
                                                  sourceFile.c_str(),
                                                  args.argv, args.argc,
                                                  nullptr, 0,
@@ -228,8 +216,10 @@ CXXJunkDetector::translationUnit(const SourceLocation &location,
   if (unit == nullptr) {
     Logger::error() << "Cannot parse translation unit: " << sourceFile << "\n";
     Logger::error() << "CXErrorCode: " << code << "\n";
-    return nullptr;
   }
+
+  /// A unit that cannot be parsed is not parsed again for every mutation point
+  std::lock_guard<std::mutex> guard(mutex);
   units[sourceFile] = unit;
   return unit;
 }
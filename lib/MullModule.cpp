@@ -1,6 +1,7 @@
 #include "MullModule.h"
 #include "Logger.h"
 #include "LLVMCompatibility.h"
+#include "MutationPoint.h"
 
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
@@ -43,3 +44,48 @@ std::unique_ptr<MullModule> MullModule::clone(LLVMContext &context) {
   auto module = make_unique<MullModule>(std::move(llvmModule.get()), "", modulePath);
   return module;
 }
+
+StringRef MullModule::internString(StringRef string) {
+  std::lock_guard<std::mutex> lock(stringsMutex);
+  return strings.insert(string).first->getKey();
+}
+
+/// Functions may be added to the module after it was indexed, e.g. the
+/// declarations of the instrumentation callbacks, hence a miss reindexes it
+void MullModule::indexFunctions() {
+  functions.clear();
+  functionIndices.clear();
+  for (auto &function : module->getFunctionList()) {
+    functionIndices[&function] = static_cast<int>(functions.size());
+    functions.push_back(&function);
+  }
+}
+
+int MullModule::getFunctionIndex(Function *function) {
+  assert(function->getParent() == module.get() &&
+         "Expected function to be found in module");
+
+  std::lock_guard<std::mutex> lock(functionsMutex);
+  auto index = functionIndices.find(function);
+  if (index == functionIndices.end()) {
+    indexFunctions();
+    index = functionIndices.find(function);
+  }
+  assert(index != functionIndices.end() && "Expected function to be found in module");
+  return index->second;
+}
+
+Function *MullModule::getFunction(int index) {
+  std::lock_guard<std::mutex> lock(functionsMutex);
+  if (index >= static_cast<int>(functions.size())) {
+    indexFunctions();
+  }
+  assert(index < static_cast<int>(functions.size()) && "Function index out of range");
+  return functions[index];
+}
+
+Instruction &MullModule::findInstruction(const MutationPointAddress &address) {
+  Function *function = getFunction(address.getFnIndex());
+  BasicBlock &basicBlock = *(std::next(function->begin(), address.getBBIndex()));
+  return *(std::next(basicBlock.begin(), address.getIIndex()));
+}
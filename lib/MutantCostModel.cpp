@@ -0,0 +1,73 @@
+#include "MutantCostModel.h"
+
+#include "MullModule.h"
+#include "MutationPoint.h"
+#include "Test.h"
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+
+#include <cmath>
+
+using namespace mull;
+using namespace llvm;
+
+constexpr double MutantCostModel::CompileTimePerInstruction;
+constexpr double MutantCostModel::UnknownTestRunningTime;
+constexpr double MutantCostModel::TestFailureProbability;
+
+MutantCostModel::MutantCostModel(bool failFast)
+    : failFast(failFast), moduleSizes() {}
+
+double MutantCostModel::testRunningTime(Test *test) {
+  auto &result = test->getExecutionResult();
+  if (result.status == ExecutionStatus::Invalid) {
+    return UnknownTestRunningTime;
+  }
+  return result.runningTime;
+}
+
+double MutantCostModel::testRunProbability(size_t position, bool failFast) {
+  if (!failFast) {
+    return 1;
+  }
+  return std::pow(1 - TestFailureProbability, position);
+}
+
+size_t MutantCostModel::moduleSize(MullModule *module) {
+  auto cached = moduleSizes.find(module);
+  if (cached != moduleSizes.end()) {
+    return cached->second;
+  }
+
+  size_t size = 0;
+  for (auto &function : module->getModule()->getFunctionList()) {
+    for (auto &block : function) {
+      size += block.size();
+    }
+  }
+  moduleSizes[module] = size;
+  return size;
+}
+
+double MutantCostModel::compileTime(MutationPoint *point) {
+  return moduleSize(point->getOriginalModule()) * CompileTimePerInstruction;
+}
+
+double MutantCostModel::executionTime(MutationPoint *point) {
+  double time = 0;
+  size_t position = 0;
+  for (auto &reachableTest : point->getReachableTests()) {
+    time += testRunningTime(reachableTest.first) *
+            testRunProbability(position++, failFast);
+  }
+  return time;
+}
+
+double MutantCostModel::cost(MutationPoint *point) {
+  /// Mutants not covered by any test are not compiled either
+  if (point->getReachableTests().empty()) {
+    return 0;
+  }
+  return compileTime(point) + executionTime(point);
+}
@@ -1,6 +1,7 @@
 #include "MutationPoint.h"
 #include "Toolchain/Compiler.h"
 #include "ModuleLoader.h"
+#include "Test.h"
 
 #include "Mutators/Mutator.h"
 #include <llvm/Transforms/Utils/Cloning.h>
@@ -11,26 +12,10 @@ using namespace std;
 
 #pragma mark - MutationPointAddress
 
-Instruction &MutationPointAddress::findInstruction(Module *module) {
-  llvm::Function &function = *(std::next(module->begin(), getFnIndex()));
-  llvm::BasicBlock &bb = *(std::next(function.begin(), getBBIndex()));
-  llvm::Instruction &instruction = *(std::next(bb.begin(), getIIndex()));
-
-  return instruction;
-}
-
-int MutationPointAddress::getFunctionIndex(Function *function) {
-  auto PM = function->getParent();
-
-  auto FII = std::find_if(PM->begin(), PM->end(),
-                          [function] (llvm::Function &f) {
-                            return &f == function;
-                          });
-
-  assert(FII != PM->end() && "Expected function to be found in module");
-  int FIndex = std::distance(PM->begin(), FII);
-
-  return FIndex;
+std::string MutationPointAddress::getIdentifier() const {
+  return std::to_string(FnIndex) + "_" +
+    std::to_string(BBIndex) + "_" +
+    std::to_string(IIndex);
 }
 
 void
@@ -58,16 +43,13 @@ MutationPoint::MutationPoint(Mutator *mutator,
                              MutationPointAddress Address,
                              Value *Val,
                              MullModule *m,
-                             std::string diagnostics,
                              const SourceLocation &location) :
   mutator(mutator), Address(Address), OriginalValue(Val),
-  module(m), diagnostics(diagnostics), sourceLocation(location), reachableTests()
+  module(m),
+  directory(m->internString(location.directory)),
+  filePath(m->internString(location.filePath)),
+  line(location.line), column(location.column), reachableTests()
 {
-  string moduleID = module->getUniqueIdentifier();
-  string addressID = Address.getIdentifier();
-  string mutatorID = mutator->getUniqueIdentifier();
-
-  uniqueIdentifier = moduleID + "_" + addressID + "_" + mutatorID;
 }
 
 MutationPoint::~MutationPoint() {}
@@ -76,7 +58,7 @@ Mutator *MutationPoint::getMutator() {
   return mutator;
 }
 
-MutationPointAddress MutationPoint::getAddress() {
+const MutationPointAddress &MutationPoint::getAddress() {
   return Address;
 }
 
@@ -92,7 +74,7 @@ Mutator *MutationPoint::getMutator() const {
   return mutator;
 }
 
-MutationPointAddress MutationPoint::getAddress() const {
+const MutationPointAddress &MutationPoint::getAddress() const {
   return Address;
 }
 
@@ -104,34 +86,47 @@ MullModule *MutationPoint::getOriginalModule() const {
   return module;
 }
 
-void MutationPoint::addReachableTest(Test *test, int distance) {
-  reachableTests.push_back(make_pair(test, distance));
+void MutationPoint::setReachableTests(std::shared_ptr<const ReachableTests> tests) {
+  reachableTests = std::move(tests);
 }
 
 void MutationPoint::applyMutation(MullModule &module) {
-  mutator->applyMutation(module.getModule(), Address);
+  mutator->applyMutation(&module, Address);
 }
 
-const std::vector<std::pair<Test *, int>> &MutationPoint::getReachableTests() const {
-  return reachableTests;
+const ReachableTests &MutationPoint::getReachableTests() const {
+  static const ReachableTests noTests;
+  if (!reachableTests) {
+    return noTests;
+  }
+  return *reachableTests;
+}
+
+uint64_t MutationPoint::getCallCount() const {
+  Function *function = cast<Instruction>(OriginalValue)->getFunction();
+  uint64_t calls = 0;
+  for (auto &reachable : getReachableTests()) {
+    calls += reachable.first->getCallCount(function);
+  }
+  return calls;
 }
 
 std::string MutationPoint::getUniqueIdentifier() {
-  return uniqueIdentifier;
+  return const_cast<const MutationPoint *>(this)->getUniqueIdentifier();
 }
 
 std::string MutationPoint::getUniqueIdentifier() const {
-  return uniqueIdentifier;
-}
+  string moduleID = module->getUniqueIdentifier();
+  string addressID = Address.getIdentifier();
+  string mutatorID = mutator->getUniqueIdentifier();
 
-const std::string &MutationPoint::getDiagnostics() {
-  return diagnostics;
+  return moduleID + "_" + addressID + "_" + mutatorID;
 }
 
-const std::string &MutationPoint::getDiagnostics() const {
-  return diagnostics;
+std::string MutationPoint::getDiagnostics() const {
+  return mutator->describe(*this);
 }
 
-const SourceLocation &MutationPoint::getSourceLocation() const {
-  return sourceLocation;
+SourceLocation MutationPoint::getSourceLocation() const {
+  return SourceLocation(directory.str(), filePath.str(), line, column);
 }
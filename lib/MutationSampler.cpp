@@ -0,0 +1,250 @@
+#include "MutationSampler.h"
+
+#include "MullModule.h"
+#include "MutationPoint.h"
+#include "MutationResult.h"
+#include "Mutators/Mutator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <random>
+
+using namespace mull;
+using namespace llvm;
+
+constexpr double MutationSampler::ConfidenceZ;
+
+static bool killsMutant(ExecutionStatus status) {
+  return status == ExecutionStatus::Failed ||
+         status == ExecutionStatus::Timedout ||
+         status == ExecutionStatus::Crashed ||
+         status == ExecutionStatus::AbnormalExit;
+}
+
+/// Fisher-Yates shuffle: unlike std::shuffle, it gives the same order with
+/// every standard library for the same seed
+static void shuffle(std::vector<MutationPoint *> &points, std::mt19937 &generator) {
+  for (size_t i = points.size(); i > 1; i--) {
+    size_t j = generator() % i;
+    std::swap(points[i - 1], points[j]);
+  }
+}
+
+MutationSampler::MutationSampler(uint32_t seed, size_t sampleSize)
+    : seed(seed), sampleSize(sampleSize), population(0), strata(),
+      stratumIndices() {}
+
+std::vector<size_t> MutationSampler::allocate(const std::vector<size_t> &populations,
+                                              size_t sampleSize) {
+  size_t total = std::accumulate(populations.begin(), populations.end(), size_t(0));
+  if (sampleSize >= total) {
+    return populations;
+  }
+
+  size_t nonEmptyStrata = std::count_if(populations.begin(), populations.end(),
+                                        [](size_t population) {
+                                          return population != 0;
+                                        });
+  bool everyStratum = sampleSize >= nonEmptyStrata;
+
+  std::vector<double> quotas(populations.size());
+  std::vector<size_t> sizes(populations.size());
+  size_t allocated = 0;
+  for (size_t i = 0; i < populations.size(); i++) {
+    quotas[i] = double(sampleSize) * populations[i] / total;
+    sizes[i] = std::min(populations[i], size_t(quotas[i]));
+    if (everyStratum && populations[i] != 0 && sizes[i] == 0) {
+      sizes[i] = 1;
+    }
+    allocated += sizes[i];
+  }
+
+  /// Largest remainders get the rest of the sample...
+  while (allocated < sampleSize) {
+    size_t best = populations.size();
+    for (size_t i = 0; i < populations.size(); i++) {
+      if (sizes[i] == populations[i]) {
+        continue;
+      }
+      if (best == populations.size() ||
+          quotas[i] - sizes[i] > quotas[best] - sizes[best]) {
+        best = i;
+      }
+    }
+    sizes[best]++;
+    allocated++;
+  }
+
+  /// ...and the smallest ones give back what the small strata got above
+  while (allocated > sampleSize) {
+    size_t worst = populations.size();
+    for (size_t i = 0; i < populations.size(); i++) {
+      if (sizes[i] <= 1) {
+        continue;
+      }
+      if (worst == populations.size() ||
+          quotas[i] - sizes[i] < quotas[worst] - sizes[worst]) {
+        worst = i;
+      }
+    }
+    sizes[worst]--;
+    allocated--;
+  }
+
+  return sizes;
+}
+
+std::vector<MutationPoint *>
+MutationSampler::sample(const std::vector<MutationPoint *> &points) {
+  strata.clear();
+  stratumIndices.clear();
+  population = points.size();
+
+  std::map<std::pair<std::string, std::string>, size_t> strataByKey;
+  std::vector<std::vector<MutationPoint *>> members;
+  for (auto point : points) {
+    auto key = std::make_pair(point->getMutator()->getUniqueIdentifier(),
+                              point->getOriginalModule()->getModule()->getModuleIdentifier());
+    auto inserted = strataByKey.insert(std::make_pair(key, strata.size()));
+    if (inserted.second) {
+      strata.emplace_back(key.first, key.second);
+      members.emplace_back();
+    }
+    members[inserted.first->second].push_back(point);
+  }
+
+  std::vector<size_t> populations;
+  for (auto &stratumMembers : members) {
+    populations.push_back(stratumMembers.size());
+  }
+  auto sizes = allocate(populations, sampleSize);
+
+  struct Draw {
+    double position;
+    size_t stratum;
+    MutationPoint *point;
+  };
+
+  std::mt19937 generator(seed);
+  std::vector<Draw> draws;
+  for (size_t index = 0; index < strata.size(); index++) {
+    auto &stratumMembers = members[index];
+    shuffle(stratumMembers, generator);
+
+    strata[index].population = stratumMembers.size();
+    strata[index].sampleSize = sizes[index];
+    for (size_t i = 0; i < sizes[index]; i++) {
+      draws.push_back({ (i + 0.5) / sizes[index], index, stratumMembers[i] });
+      stratumIndices[stratumMembers[i]] = index;
+    }
+  }
+
+  std::sort(draws.begin(), draws.end(), [](const Draw &lhs, const Draw &rhs) {
+    if (lhs.position != rhs.position) {
+      return lhs.position < rhs.position;
+    }
+    return lhs.stratum < rhs.stratum;
+  });
+
+  std::vector<MutationPoint *> sampled;
+  sampled.reserve(draws.size());
+  for (auto &draw : draws) {
+    sampled.push_back(draw.point);
+  }
+  return sampled;
+}
+
+void MutationSampler::record(const std::vector<std::unique_ptr<MutationResult>> &results) {
+  DenseMap<MutationPoint *, bool> killedPoints;
+  for (auto &result : results) {
+    bool &killed = killedPoints[result->getMutationPoint()];
+    killed = killed || killsMutant(result->getExecutionResult().status);
+  }
+
+  for (auto &killedPoint : killedPoints) {
+    auto index = stratumIndices.find(killedPoint.first);
+    if (index == stratumIndices.end()) {
+      continue;
+    }
+    auto &stratum = strata[index->second];
+    stratum.executed++;
+    if (killedPoint.second) {
+      stratum.killed++;
+    }
+  }
+}
+
+MutationScoreEstimate
+MutationSampler::estimate(const std::vector<SamplingStratum> &strata) {
+  MutationScoreEstimate estimate = { 0, 0, 1, 0 };
+
+  size_t executedPopulation = 0;
+  bool exhaustive = true;
+  for (auto &stratum : strata) {
+    estimate.executed += stratum.executed;
+    if (stratum.executed != 0) {
+      executedPopulation += stratum.population;
+    }
+    if (stratum.executed != stratum.population) {
+      exhaustive = false;
+    }
+  }
+
+  if (estimate.executed == 0) {
+    return estimate;
+  }
+
+  /// The strata not run yet are left out until they are
+  double variance = 0;
+  for (auto &stratum : strata) {
+    if (stratum.executed == 0) {
+      continue;
+    }
+    double weight = double(stratum.population) / executedPopulation;
+    double score = double(stratum.killed) / stratum.executed;
+    double finitePopulation = 1.0 - double(stratum.executed) / stratum.population;
+    estimate.score += weight * score;
+    variance += weight * weight * finitePopulation * score * (1 - score) /
+                stratum.executed;
+  }
+
+  /// Every mutant has been run: the score is exact
+  if (exhaustive) {
+    estimate.lower = estimate.score;
+    estimate.upper = estimate.score;
+    return estimate;
+  }
+
+  double p = estimate.score;
+  double n = estimate.executed;
+  if (variance > 0) {
+    n = p * (1 - p) / variance;
+  }
+
+  double z2 = ConfidenceZ * ConfidenceZ;
+  double denominator = 1 + z2 / n;
+  double center = (p + z2 / (2 * n)) / denominator;
+  double halfWidth = ConfidenceZ / denominator *
+                     std::sqrt(p * (1 - p) / n + z2 / (4 * n * n));
+  estimate.lower = std::max(0.0, center - halfWidth);
+  estimate.upper = std::min(1.0, center + halfWidth);
+  return estimate;
+}
+
+MutationScoreEstimate MutationSampler::estimate() const {
+  return estimate(strata);
+}
+
+uint32_t MutationSampler::getSeed() const {
+  return seed;
+}
+
+size_t MutationSampler::getPopulation() const {
+  return population;
+}
+
+const std::vector<SamplingStratum> &MutationSampler::getStrata() const {
+  return strata;
+}
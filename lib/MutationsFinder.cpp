@@ -3,27 +3,41 @@
 #include "Config.h"
 #include "Parallelization/Parallelization.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 using namespace mull;
 using namespace llvm;
 
 MutationsFinder::MutationsFinder(std::vector<std::unique_ptr<Mutator>> mutators, Config &config)
-: mutators(std::move(mutators)), config(config) {}
+: mutators(std::move(mutators)), ownedPoints(), lastPointsBegin(0), config(config) {}
 
 std::vector<MutationPoint *> MutationsFinder::getMutationPoints(const Context &context,
                                                                 std::vector<MergedTestee> &testees,
                                                                 Filter &filter) {
+  lastPointsBegin = ownedPoints.size();
+
   std::vector<SearchMutationPointsTask> tasks;
   for (int i = 0; i < config.parallelization().workers; i++) {
-    tasks.emplace_back(filter, context, mutators);
+    tasks.emplace_back(filter, context, mutators, config.blockCoverageEnabled());
   }
 
   TaskExecutor<SearchMutationPointsTask> finder("Searching mutants across functions", testees, ownedPoints, tasks);
   finder.execute();
 
   std::vector<MutationPoint *> mutationPoints;
-  for (auto &point : ownedPoints) {
-    mutationPoints.push_back(point.get());
+  for (auto it = ownedPoints.begin() + lastPointsBegin; it != ownedPoints.end(); ++it) {
+    mutationPoints.push_back(it->get());
   }
 
   return mutationPoints;
 }
+
+void MutationsFinder::discardMutationPoints(const std::vector<MutationPoint *> &kept) {
+  std::unordered_set<MutationPoint *> keptPoints(kept.begin(), kept.end());
+  auto discarded = std::stable_partition(ownedPoints.begin() + lastPointsBegin, ownedPoints.end(),
+                                         [&](const std::unique_ptr<MutationPoint> &point) {
+                                           return keptPoints.count(point.get()) != 0;
+                                         });
+  ownedPoints.erase(discarded, ownedPoints.end());
+}
@@ -26,12 +26,21 @@ AndOrReplacementMutator::getMutationPoint(MullModule *module,
                                           llvm::Instruction *instruction,
                                           SourceLocation &sourceLocation) {
   if (canBeApplied(*instruction)) {
-    std::string diagnostics = "AND-OR Replacement";
-    return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    return new MutationPoint(this, address, instruction, module, sourceLocation);
   }
   return nullptr;
 }
 
+std::string AndOrReplacementMutator::describe(const MutationPoint &point) const {
+  return "AND-OR Replacement";
+}
+
+std::vector<unsigned> AndOrReplacementMutator::getOpcodes() const {
+  return {
+    Instruction::Br
+  };
+}
+
 bool AndOrReplacementMutator::canBeApplied(Value &V) {
   BranchInst *branchInst = dyn_cast<BranchInst>(&V);
 
@@ -62,9 +71,9 @@ bool AndOrReplacementMutator::canBeApplied(Value &V) {
   return false;
 }
 
-llvm::Value *AndOrReplacementMutator::applyMutation(llvm::Module *module,
+llvm::Value *AndOrReplacementMutator::applyMutation(MullModule *module,
                                                     MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   BranchInst *branchInst = dyn_cast<BranchInst>(&I);
   assert(branchInst != nullptr);
@@ -228,10 +228,23 @@ ConditionalsBoundaryMutator::getMutationPoint(MullModule *module,
     return nullptr;
   }
 
-  std::string diagnostics = getDiagnostics(originalPredicate,
-                                           mutatedPredicate.getValue());
+  return new MutationPoint(this, address, instruction, module, sourceLocation);
+}
+
+std::string ConditionalsBoundaryMutator::describe(const MutationPoint &point) const {
+  CmpInst *cmpOp = cast<CmpInst>(point.getOriginalValue());
+  CmpInst::Predicate originalPredicate = cmpOp->getPredicate();
+  Optional<CmpInst::Predicate> mutatedPredicate = getMutatedPredicate(originalPredicate);
+  assert(mutatedPredicate.hasValue());
+
+  return getDiagnostics(originalPredicate, mutatedPredicate.getValue());
+}
 
-  return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+std::vector<unsigned> ConditionalsBoundaryMutator::getOpcodes() const {
+  return {
+    Instruction::ICmp,
+    Instruction::FCmp
+  };
 }
 
 bool ConditionalsBoundaryMutator::canBeApplied(Value &V) {
@@ -239,9 +252,9 @@ bool ConditionalsBoundaryMutator::canBeApplied(Value &V) {
   return false;
 }
 
-llvm::Value *ConditionalsBoundaryMutator::applyMutation(llvm::Module *module,
+llvm::Value *ConditionalsBoundaryMutator::applyMutation(MullModule *module,
                                                         MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   CmpInst *cmp = cast<CmpInst>(&I);
 
@@ -113,14 +113,25 @@ MathAddMutator::getMutationPoint(MullModule *module,
                                  llvm::Instruction *instruction,
                                  SourceLocation &sourceLocation) {
   if (canBeApplied(*instruction)) {
-    std::string diagnostics = "Math Add: replaced + with -";
-
-    return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    return new MutationPoint(this, address, instruction, module, sourceLocation);
   }
 
   return nullptr;
 }
 
+std::string MathAddMutator::describe(const MutationPoint &point) const {
+  return "Math Add: replaced + with -";
+}
+
+/// Calls to the add with overflow intrinsics are mutated as well
+std::vector<unsigned> MathAddMutator::getOpcodes() const {
+  return {
+    Instruction::Add,
+    Instruction::FAdd,
+    Instruction::Call
+  };
+}
+
 bool MathAddMutator::canBeApplied(Value &V) {
   if (BinaryOperator *BinOp = dyn_cast<BinaryOperator>(&V)) {
     BinaryOperator::BinaryOps Opcode = BinOp->getOpcode();
@@ -138,9 +149,9 @@ bool MathAddMutator::canBeApplied(Value &V) {
 }
 
 llvm::Value *
-MathAddMutator::applyMutation(llvm::Module *module,
+MathAddMutator::applyMutation(MullModule *module,
                               MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   if (isAddWithOverflow(I)) {
     CallInst *callInst = dyn_cast<CallInst>(&I);
@@ -24,13 +24,24 @@ MathDivMutator::getMutationPoint(MullModule *module,
                                  llvm::Instruction *instruction,
                                  SourceLocation &sourceLocation) {
   if (canBeApplied(*instruction)) {
-    std::string diagnostics = "Math Div: replaced / with *";
-    return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    return new MutationPoint(this, address, instruction, module, sourceLocation);
   }
 
   return nullptr;
 }
 
+std::string MathDivMutator::describe(const MutationPoint &point) const {
+  return "Math Div: replaced / with *";
+}
+
+std::vector<unsigned> MathDivMutator::getOpcodes() const {
+  return {
+    Instruction::UDiv,
+    Instruction::SDiv,
+    Instruction::FDiv
+  };
+}
+
 bool MathDivMutator::canBeApplied(Value &V) {
   if (BinaryOperator *BinOp = dyn_cast<BinaryOperator>(&V)) {
     BinaryOperator::BinaryOps Opcode = BinOp->getOpcode();
@@ -45,9 +56,9 @@ bool MathDivMutator::canBeApplied(Value &V) {
   return false;
 }
 
-llvm::Value *MathDivMutator::applyMutation(llvm::Module *module,
+llvm::Value *MathDivMutator::applyMutation(MullModule *module,
                                            MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   /// TODO: Take care of NUW/NSW
   BinaryOperator *binaryOperator = cast<BinaryOperator>(&I);
@@ -24,12 +24,22 @@ MathMulMutator::getMutationPoint(MullModule *module,
                                  llvm::Instruction *instruction,
                                  SourceLocation &sourceLocation) {
   if (canBeApplied(*instruction)) {
-    std::string diagnostics = "Math Mul: replaced * with /";
-    return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    return new MutationPoint(this, address, instruction, module, sourceLocation);
   }
   return nullptr;
 }
 
+std::string MathMulMutator::describe(const MutationPoint &point) const {
+  return "Math Mul: replaced * with /";
+}
+
+std::vector<unsigned> MathMulMutator::getOpcodes() const {
+  return {
+    Instruction::Mul,
+    Instruction::FMul
+  };
+}
+
 bool MathMulMutator::canBeApplied(Value &V) {
   if (BinaryOperator *BinOp = dyn_cast<BinaryOperator>(&V)) {
     BinaryOperator::BinaryOps Opcode = BinOp->getOpcode();
@@ -42,9 +52,9 @@ bool MathMulMutator::canBeApplied(Value &V) {
   return false;
 }
 
-llvm::Value *MathMulMutator::applyMutation(llvm::Module *module,
+llvm::Value *MathMulMutator::applyMutation(MullModule *module,
                                            MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   /// TODO: Take care of NUW/NSW
   BinaryOperator *binaryOperator = cast<BinaryOperator>(&I);
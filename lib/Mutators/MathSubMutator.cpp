@@ -112,12 +112,24 @@ MathSubMutator::getMutationPoint(MullModule *module,
                                  llvm::Instruction *instruction,
                                  SourceLocation &sourceLocation) {
   if (canBeApplied(*instruction)) {
-    std::string diagnostics = "Math Sub: replaced - with +";
-    return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    return new MutationPoint(this, address, instruction, module, sourceLocation);
   }
   return nullptr;
 }
 
+std::string MathSubMutator::describe(const MutationPoint &point) const {
+  return "Math Sub: replaced - with +";
+}
+
+/// Calls to the sub with overflow intrinsics are mutated as well
+std::vector<unsigned> MathSubMutator::getOpcodes() const {
+  return {
+    Instruction::Sub,
+    Instruction::FSub,
+    Instruction::Call
+  };
+}
+
 bool MathSubMutator::canBeApplied(Value &V) {
   if (BinaryOperator *BinOp = dyn_cast<BinaryOperator>(&V)) {
     BinaryOperator::BinaryOps Opcode = BinOp->getOpcode();
@@ -134,9 +146,9 @@ bool MathSubMutator::canBeApplied(Value &V) {
   return false;
 }
 
-llvm::Value *MathSubMutator::applyMutation(llvm::Module *module,
+llvm::Value *MathSubMutator::applyMutation(MullModule *module,
                                            MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   if (isSubWithOverflow(I)) {
     CallInst *callInst = dyn_cast<CallInst>(&I);
@@ -290,15 +290,24 @@ NegateConditionMutator::getMutationPoint(MullModule *module,
       return nullptr;
     }
 
-    std::string diagnostics =
-      getDiagnostics(cmpOp->getPredicate(),
-                     negatedCmpInstPredicate(cmpOp->getPredicate()));
-
-    return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    return new MutationPoint(this, address, instruction, module, sourceLocation);
   }
   return nullptr;
 }
 
+std::string NegateConditionMutator::describe(const MutationPoint &point) const {
+  CmpInst *cmpOp = cast<CmpInst>(point.getOriginalValue());
+  return getDiagnostics(cmpOp->getPredicate(),
+                        negatedCmpInstPredicate(cmpOp->getPredicate()));
+}
+
+std::vector<unsigned> NegateConditionMutator::getOpcodes() const {
+  return {
+    Instruction::ICmp,
+    Instruction::FCmp
+  };
+}
+
 bool NegateConditionMutator::canBeApplied(Value &V) {
 
   if (CmpInst *cmpOp = dyn_cast<CmpInst>(&V)) {
@@ -316,9 +325,9 @@ bool NegateConditionMutator::canBeApplied(Value &V) {
   return false;
 }
 
-llvm::Value *NegateConditionMutator::applyMutation(llvm::Module *module,
+llvm::Value *NegateConditionMutator::applyMutation(MullModule *module,
                                                    MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   CmpInst *cmpInstruction = cast<CmpInst>(&I);
 
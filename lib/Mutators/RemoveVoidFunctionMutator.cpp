@@ -41,13 +41,22 @@ RemoveVoidFunctionMutator::getMutationPoint(MullModule *module,
                                             llvm::Instruction *instruction,
                                             SourceLocation &sourceLocation) {
   if (canBeApplied(*instruction)) {
-    std::string diagnostics = getDiagnostics(*instruction);
-    return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    return new MutationPoint(this, address, instruction, module, sourceLocation);
   }
 
   return nullptr;
 }
 
+std::string RemoveVoidFunctionMutator::describe(const MutationPoint &point) const {
+  return getDiagnostics(*cast<Instruction>(point.getOriginalValue()));
+}
+
+std::vector<unsigned> RemoveVoidFunctionMutator::getOpcodes() const {
+  return {
+    Instruction::Call
+  };
+}
+
 bool RemoveVoidFunctionMutator::canBeApplied(Value &V) {
   if (CallInst *callInst = dyn_cast<CallInst>(&V)) {
 
@@ -91,9 +100,9 @@ bool RemoveVoidFunctionMutator::canBeApplied(Value &V) {
   return false;
 }
 
-llvm::Value *RemoveVoidFunctionMutator::applyMutation(llvm::Module *module,
+llvm::Value *RemoveVoidFunctionMutator::applyMutation(MullModule *module,
                                                       MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   CallInst *callInst = dyn_cast<CallInst>(&I);
   callInst->eraseFromParent();
@@ -19,19 +19,28 @@ using namespace mull;
 
 const std::string ReplaceAssignmentMutator::ID = "replace_assignment_mutator";
 
-static bool findPossibleApplication(Value &V, std::string &outDiagnostics);
+/// The diagnostics are rendered only when asked for
+static bool findPossibleApplication(Value &V, std::string *outDiagnostics);
+std::string ReplaceAssignmentMutator::describe(const MutationPoint &point) const {
+  std::string diagnostics;
+  findPossibleApplication(*point.getOriginalValue(), &diagnostics);
+  return diagnostics;
+}
+
 static
 llvm::Value *getReplacement(Type *returnType, llvm::LLVMContext &context);
 
-bool ReplaceAssignmentMutator::canBeApplied(Value &V) {
-  std::string diagnostics;
-
-  return findPossibleApplication(V, diagnostics);
+std::vector<unsigned> ReplaceAssignmentMutator::getOpcodes() const {
+  return {
+    Instruction::Store
+  };
 }
 
-static bool findPossibleApplication(Value &V, std::string &outDiagnostics) {
+bool ReplaceAssignmentMutator::canBeApplied(Value &V) {
+  return findPossibleApplication(V, nullptr);
+}
 
-  std::string diagnostics;
+static bool findPossibleApplication(Value &V, std::string *outDiagnostics) {
 
   Instruction *instruction = dyn_cast<Instruction>(&V);
   assert(instruction);
@@ -48,11 +57,15 @@ static bool findPossibleApplication(Value &V, std::string &outDiagnostics) {
     return false;
   }
 
+  if (outDiagnostics == nullptr) {
+    return true;
+  }
+
   std::stringstream diagnosticsStream;
 
   diagnosticsStream << "Replace Assignment: replaced rvalue with 42";
 
-  outDiagnostics.assign(diagnosticsStream.str());
+  outDiagnostics->assign(diagnosticsStream.str());
 
   return true;
 }
@@ -63,14 +76,12 @@ ReplaceAssignmentMutator::getMutationPoint(MullModule *module,
                                            llvm::Instruction *instruction,
                                            SourceLocation &sourceLocation) {
 
-  std::string diagnostics;
-
-  if (findPossibleApplication(*instruction, diagnostics) == false) {
+  if (findPossibleApplication(*instruction, nullptr) == false) {
     return nullptr;
   }
 
   auto mutationPoint =
-    new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    new MutationPoint(this, address, instruction, module, sourceLocation);
 
   return mutationPoint;
 }
@@ -101,9 +112,9 @@ llvm::Value *getReplacement(Type *returnType, llvm::LLVMContext &context) {
 }
 
 llvm::Value *
-ReplaceAssignmentMutator::applyMutation(llvm::Module *module,
+ReplaceAssignmentMutator::applyMutation(MullModule *module,
                                         MutationPointAddress &address) {
-  llvm::Instruction &instruction = address.findInstruction(module);
+  llvm::Instruction &instruction = module->findInstruction(address);
 
   StoreInst *storeInstruction = dyn_cast<StoreInst>(&instruction);
 
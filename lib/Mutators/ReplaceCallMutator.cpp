@@ -19,17 +19,21 @@ using namespace mull;
 
 const std::string ReplaceCallMutator::ID = "replace_call_mutator";
 
-static bool findPossibleApplication(Value &V, std::string &outDiagnostics);
+/// The diagnostics are rendered only when asked for
+static bool findPossibleApplication(Value &V, std::string *outDiagnostics);
+
+std::vector<unsigned> ReplaceCallMutator::getOpcodes() const {
+  return {
+    Instruction::Call,
+    Instruction::Invoke
+  };
+}
 
 bool ReplaceCallMutator::canBeApplied(Value &V) {
-  std::string diagnostics;
-
-  return findPossibleApplication(V, diagnostics);
+  return findPossibleApplication(V, nullptr);
 }
 
-static bool findPossibleApplication(Value &V, std::string &outDiagnostics) {
-
-  std::string diagnostics;
+static bool findPossibleApplication(Value &V, std::string *outDiagnostics) {
 
   Instruction *instruction = dyn_cast<Instruction>(&V);
   assert(instruction);
@@ -54,6 +58,10 @@ static bool findPossibleApplication(Value &V, std::string &outDiagnostics) {
     return false;
   }
 
+  if (outDiagnostics == nullptr) {
+    return true;
+  }
+
   std::stringstream diagnosticsStream;
 
   diagnosticsStream << "Replace Call: replaced a call to function ";
@@ -63,7 +71,7 @@ static bool findPossibleApplication(Value &V, std::string &outDiagnostics) {
   }
   diagnosticsStream << "with 42";
 
-  outDiagnostics.assign(diagnosticsStream.str());
+  outDiagnostics->assign(diagnosticsStream.str());
 
   return true;
 }
@@ -74,18 +82,22 @@ ReplaceCallMutator::getMutationPoint(MullModule *module,
                                      llvm::Instruction *instruction,
                                      SourceLocation &sourceLocation) {
 
-  std::string diagnostics;
-
-  if (findPossibleApplication(*instruction, diagnostics) == false) {
+  if (findPossibleApplication(*instruction, nullptr) == false) {
     return nullptr;
   }
 
   auto mutationPoint =
-    new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+    new MutationPoint(this, address, instruction, module, sourceLocation);
 
   return mutationPoint;
 }
 
+std::string ReplaceCallMutator::describe(const MutationPoint &point) const {
+  std::string diagnostics;
+  findPossibleApplication(*point.getOriginalValue(), &diagnostics);
+  return diagnostics;
+}
+
 static
 llvm::Value *getReplacement(Type *returnType, llvm::LLVMContext &context) {
   static const int MagicValue = 42;
@@ -112,9 +124,9 @@ llvm::Value *getReplacement(Type *returnType, llvm::LLVMContext &context) {
 }
 
 llvm::Value *
-ReplaceCallMutator::applyMutation(llvm::Module *module,
+ReplaceCallMutator::applyMutation(MullModule *module,
                                   MutationPointAddress &address) {
-  llvm::Instruction &instruction = address.findInstruction(module);
+  llvm::Instruction &instruction = module->findInstruction(address);
 
   CallSite callSite(&instruction);
 
@@ -28,9 +28,10 @@ const std::string ScalarValueMutator::ID = "scalar_value_mutator";
 
 #pragma mark - Prototypes
 
+/// The diagnostics are rendered only when asked for
 static
 ScalarValueMutationType findPossibleApplication(Value &V,
-                                                std::string &outDiagnostics);
+                                                std::string *outDiagnostics);
 static ConstantInt *getReplacementInt(ConstantInt *constantInt);
 static ConstantFP *getReplacementFloat(ConstantFP *constantFloat);
 
@@ -41,25 +42,45 @@ ScalarValueMutator::getMutationPoint(MullModule *module,
                                      MutationPointAddress &address,
                                      llvm::Instruction *instruction,
                                      SourceLocation &sourceLocation) {
-  std::string diagnostics;
   ScalarValueMutationType mutationType =
-    findPossibleApplication(*instruction, diagnostics);
+    findPossibleApplication(*instruction, nullptr);
   if (mutationType == ScalarValueMutationType::None) {
     return nullptr;
   }
 
-  return new MutationPoint(this, address, instruction, module, diagnostics, sourceLocation);
+  return new MutationPoint(this, address, instruction, module, sourceLocation);
+}
+
+std::string ScalarValueMutator::describe(const MutationPoint &point) const {
+  std::string diagnostics;
+  findPossibleApplication(*point.getOriginalValue(), &diagnostics);
+  return diagnostics;
+}
+
+std::vector<unsigned> ScalarValueMutator::getOpcodes() const {
+  std::vector<unsigned> opcodes;
+  for (unsigned opcode = Instruction::BinaryOpsBegin;
+       opcode < Instruction::BinaryOpsEnd;
+       opcode++) {
+    opcodes.push_back(opcode);
+  }
+  opcodes.push_back(Instruction::Store);
+  opcodes.push_back(Instruction::FCmp);
+  opcodes.push_back(Instruction::ICmp);
+  opcodes.push_back(Instruction::Ret);
+  opcodes.push_back(Instruction::Call);
+  opcodes.push_back(Instruction::Invoke);
+  return opcodes;
 }
 
 /// Currently only used by SimpleTestFinder.
 bool ScalarValueMutator::canBeApplied(Value &V) {
-  std::string diagnostics;
-  return findPossibleApplication(V, diagnostics) != ScalarValueMutationType::None;
+  return findPossibleApplication(V, nullptr) != ScalarValueMutationType::None;
 }
 
 static
 ScalarValueMutationType findPossibleApplication(Value &V,
-                                                std::string &outDiagnostics) {
+                                                std::string *outDiagnostics) {
   Instruction *instruction = dyn_cast<Instruction>(&V);
   assert(instruction);
 
@@ -86,15 +107,19 @@ ScalarValueMutationType findPossibleApplication(Value &V,
       if (ConstantInt *constantInt = dyn_cast<ConstantInt>(operand)) {
         auto intValue = constantInt->getValue();
 
-        auto replacementInt = getReplacementInt(constantInt);
-        auto replacementIntValue = replacementInt->getValue();
-
         /// Skip big number because getSExtValue throws otherwise.
         /// TODO: consider these edge cases in unit tests.
         if (intValue.getNumWords() > 1) {
           continue;
         }
 
+        if (outDiagnostics == nullptr) {
+          return ScalarValueMutationType::Int;
+        }
+
+        auto replacementInt = getReplacementInt(constantInt);
+        auto replacementIntValue = replacementInt->getValue();
+
         std::stringstream diagstream;
         diagstream << "Scalar Value Replacement: ";
 
@@ -102,12 +127,16 @@ ScalarValueMutationType findPossibleApplication(Value &V,
         diagstream << " -> ";
         diagstream << replacementIntValue.getSExtValue();
 
-        outDiagnostics.assign(diagstream.str());
+        outDiagnostics->assign(diagstream.str());
 
         return ScalarValueMutationType::Int;
       }
 
       if (ConstantFP *constantFloat = dyn_cast<ConstantFP>(operand)) {
+        if (outDiagnostics == nullptr) {
+          return ScalarValueMutationType::Float;
+        }
+
         auto floatValue = constantFloat->getValueAPF();
         auto replacementFloat = getReplacementFloat(constantFloat);
         auto replacementFloatValue = replacementFloat->getValueAPF();
@@ -119,7 +148,7 @@ ScalarValueMutationType findPossibleApplication(Value &V,
         diagstream << " -> ";
         diagstream << replacementFloatValue.convertToDouble();
 
-        outDiagnostics.assign(diagstream.str());
+        outDiagnostics->assign(diagstream.str());
 
         return ScalarValueMutationType::Float;
       }
@@ -169,9 +198,9 @@ static ConstantFP *getReplacementFloat(ConstantFP *constantFloat) {
 }
 
 llvm::Value *
-ScalarValueMutator::applyMutation(llvm::Module *module,
+ScalarValueMutator::applyMutation(MullModule *module,
                                   MutationPointAddress &address) {
-  llvm::Instruction &I = address.findInstruction(module);
+  llvm::Instruction &I = module->findInstruction(address);
 
   for (unsigned int i = 0; i < I.getNumOperands(); i++) {
     Value *operand = I.getOperand(i);
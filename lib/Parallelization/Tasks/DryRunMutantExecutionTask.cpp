@@ -1,20 +1,33 @@
 #include "Parallelization/Tasks/DryRunMutantExecutionTask.h"
 #include "Parallelization/Progress.h"
+#include "MutantCostModel.h"
 
 using namespace mull;
 using namespace llvm;
 
+DryRunMutantExecutionTask::DryRunMutantExecutionTask(bool failFast)
+    : failFast(failFast) {}
+
 void DryRunMutantExecutionTask::operator()(iterator begin, iterator end, Out &storage,
                                            progress_counter &counter) {
   for (auto it = begin; it != end; it++, counter.increment()) {
     auto mutationPoint = *it;
+    if (mutationPoint->getReachableTests().empty()) {
+      ExecutionResult result;
+      result.status = NotCovered;
+      storage.push_back(make_unique<MutationResult>(result, mutationPoint, -1, nullptr));
+      continue;
+    }
+    size_t position = 0;
     for (auto &reachableTest : mutationPoint->getReachableTests()) {
       auto test = reachableTest.first;
       auto distance = reachableTest.second;
-      auto timeout = test->getExecutionResult().runningTime * 10;
+      /// The predicted running time, weighted by the chance the test is run
+      double predictedTime = MutantCostModel::testRunningTime(test) *
+                             MutantCostModel::testRunProbability(position++, failFast);
       ExecutionResult result;
       result.status = DryRun;
-      result.runningTime = timeout;
+      result.runningTime = static_cast<long long>(predictedTime);
       storage.push_back(make_unique<MutationResult>(result, mutationPoint, distance, test));
     }
   }
@@ -2,15 +2,20 @@
 #include "Parallelization/Progress.h"
 #include "Toolchain/Toolchain.h"
 #include "Instrumentation/Instrumentation.h"
+#include "Instrumentation/ExecutionBudget.h"
+#include "Config.h"
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/Support/TargetSelect.h>
 
 using namespace mull;
 using namespace llvm;
+using namespace llvm::object;
 
-InstrumentedCompilationTask::InstrumentedCompilationTask(Instrumentation &instrumentation, Toolchain &toolchain)
-    : instrumentation(instrumentation), toolchain(toolchain) {}
+InstrumentedCompilationTask::InstrumentedCompilationTask(Instrumentation &instrumentation,
+                                                         Toolchain &toolchain,
+                                                         Config &config)
+    : instrumentation(instrumentation), toolchain(toolchain), config(config) {}
 
 void mull::InstrumentedCompilationTask::operator()(mull::InstrumentedCompilationTask::iterator begin,
                                                    mull::InstrumentedCompilationTask::iterator end,
@@ -21,16 +26,28 @@ void mull::InstrumentedCompilationTask::operator()(mull::InstrumentedCompilation
                                      llvm::SmallVector<std::string, 1>());
   std::unique_ptr<TargetMachine> localMachine(target);
 
+  /// Which functions are instrumented depends on the tests as well,
+  /// such object files are not cached
+  bool useCache = instrumentation.instrumentsAllFunctions();
+
   for (auto it = begin; it != end; it++, counter.increment()) {
     auto &module = *it->get();
-    auto objectFile = toolchain.cache().getInstrumentedObject(module);
+    OwningBinary<ObjectFile> objectFile;
+    if (useCache) {
+      objectFile = toolchain.cache().getInstrumentedObject(module);
+    }
     if (objectFile.getBinary() == nullptr) {
       LLVMContext instrumentationContext;
       auto clonedModule = module.clone(instrumentationContext);
 
       instrumentation.insertCallbacks(clonedModule->getModule());
+      if (config.executionBudgetEnabled()) {
+        ExecutionBudget::insertCounters(clonedModule->getModule());
+      }
       objectFile = toolchain.compiler().compileModule(*clonedModule, *localMachine);
-      toolchain.cache().putInstrumentedObject(objectFile, module);
+      if (useCache) {
+        toolchain.cache().putInstrumentedObject(objectFile, module);
+      }
     }
     storage.push_back(std::move(objectFile));
   }
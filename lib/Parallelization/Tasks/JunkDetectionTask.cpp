@@ -1,6 +1,13 @@
 #include "Parallelization/Tasks/JunkDetectionTask.h"
 #include "Parallelization/Progress.h"
 #include "JunkDetection/JunkDetector.h"
+#include "MullModule.h"
+#include "MutationPoint.h"
+
+#include <llvm/IR/Module.h>
+
+#include <map>
+#include <string>
 
 using namespace mull;
 
@@ -10,12 +17,26 @@ JunkDetectionTask::JunkDetectionTask(JunkDetector &detector)
 void JunkDetectionTask::operator()(iterator begin, iterator end,
                                    Out &storage, progress_counter &counter) {
   for (auto it = begin; it != end; ++it, counter.increment()) {
-    auto point = *it;
-    if (detector.isJunk(point)) {
-      continue;
+    for (auto point : *it) {
+      if (detector.isJunk(point)) {
+        continue;
+      }
+      storage.push_back(point);
     }
-    storage.push_back(point);
   }
 }
 
-
+JunkDetectionTask::In
+JunkDetectionTask::groupByTranslationUnit(const std::vector<MutationPoint *> &points) {
+  In units;
+  std::map<std::string, size_t> unitIndices;
+  for (auto point : points) {
+    auto &sourceFile = point->getOriginalModule()->getModule()->getSourceFileName();
+    auto inserted = unitIndices.insert(std::make_pair(sourceFile, units.size()));
+    if (inserted.second) {
+      units.emplace_back();
+    }
+    units[inserted.first->second].push_back(point);
+  }
+  return units;
+}
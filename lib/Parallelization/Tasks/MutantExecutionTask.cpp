@@ -2,7 +2,10 @@
 #include "Parallelization/Progress.h"
 #include "Driver.h"
 #include "Config.h"
+#include "Instrumentation/ExecutionBudget.h"
+#include "TestBatch.h"
 #include "TestRunner.h"
+#include "Zygote.h"
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/Support/TargetSelect.h>
@@ -10,14 +13,31 @@
 using namespace mull;
 using namespace llvm;
 
+static long long testTimeout(Test *test, Config &config) {
+  /// The original tests are not run with 'reachability: static'
+  if (test->getExecutionResult().status == ExecutionStatus::Invalid) {
+    return config.getTimeout();
+  }
+  const auto timeout = test->getExecutionResult().runningTime * 10;
+  return std::max(30LL, timeout);
+}
+
+static bool isAbnormal(ExecutionStatus status) {
+  return status == ExecutionStatus::Crashed ||
+         status == ExecutionStatus::Timedout ||
+         status == ExecutionStatus::AbnormalExit;
+}
+
 mull::MutantExecutionTask::MutantExecutionTask(Driver &driver,
                                                ProcessSandbox &sandbox,
                                                TestRunner &runner,
                                                Config &config,
                                                Toolchain &toolchain,
-                                               Filter &filter)
+                                               Filter &filter,
+                                               Zygote *zygote)
     : sandbox(sandbox), runner(runner),
-      config(config), toolchain(toolchain), filter(filter), driver(driver) {}
+      config(config), toolchain(toolchain), filter(filter), driver(driver),
+      zygote(zygote) {}
 
 void MutantExecutionTask::operator()(MutantExecutionTask::iterator begin,
                                      MutantExecutionTask::iterator end,
@@ -30,6 +50,14 @@ void MutantExecutionTask::operator()(MutantExecutionTask::iterator begin,
 
   for (auto it = begin; it != end; ++it, counter.increment()) {
     auto mutationPoint = *it;
+    if (mutationPoint->getReachableTests().empty()) {
+      /// None of the tests executed the mutated block, see 'block_coverage'
+      ExecutionResult result;
+      result.status = ExecutionStatus::NotCovered;
+      storage.push_back(make_unique<MutationResult>(result, mutationPoint, -1, nullptr));
+      continue;
+    }
+
     auto objectFilesWithMutant = driver.AllButOne(mutationPoint->getOriginalModule()->getModule());
 
     auto mutant = toolchain.cache().getObject(*mutationPoint);
@@ -37,41 +65,207 @@ void MutantExecutionTask::operator()(MutantExecutionTask::iterator begin,
       LLVMContext localContext;
       auto clonedModule = mutationPoint->getOriginalModule()->clone(localContext);
       mutationPoint->applyMutation(*clonedModule.get());
+      if (config.executionBudgetEnabled()) {
+        ExecutionBudget::insertCounters(clonedModule->getModule());
+      }
       mutant = toolchain.compiler().compileModule(*clonedModule.get(), *localMachine);
       toolchain.cache().putObject(mutant, *mutationPoint);
     }
 
     objectFilesWithMutant.push_back(mutant.getBinary());
 
+    if (zygote && zygote->loadProgram(objectFilesWithMutant)) {
+      runTests(mutationPoint, storage, &objectFilesWithMutant);
+      zygote->unloadProgram();
+      zygote->releaseObjectFile(mutant.getBinary());
+      continue;
+    }
+
     runner.loadProgram(objectFilesWithMutant, jit);
 
-    auto atLeastOneTestFailed = false;
-    for (auto &reachableTest : mutationPoint->getReachableTests()) {
-      auto test = reachableTest.first;
-      auto distance = reachableTest.second;
+    if (config.batchTestsModeEnabled() && runner.supportsBatchExecution() &&
+        mutationPoint->getReachableTests().size() > 1) {
+      runTestsInBatch(mutationPoint, storage);
+    } else {
+      runTests(mutationPoint, storage);
+    }
+  }
+}
 
-      ExecutionResult result;
-      if (config.failFastModeEnabled() && atLeastOneTestFailed) {
-        result.status = ExecutionStatus::FailFast;
-      } else {
-        const auto timeout = test->getExecutionResult().runningTime * 10;
-        const auto sandboxTimeout = std::max(30LL, timeout);
-
-        result = sandbox.run([&]() {
-          ExecutionStatus status = runner.runTest(test, jit);
-          assert(status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
-          return status;
-        }, sandboxTimeout);
-
-        assert(result.status != ExecutionStatus::Invalid &&
-            "Expect to see valid TestResult");
-
-        if (result.status != ExecutionStatus::Passed) {
-          atLeastOneTestFailed = true;
+uint64_t MutantExecutionTask::executionBudget(Test *test) {
+  if (!config.executionBudgetEnabled()) {
+    return 0;
+  }
+  /// The original tests are not run with 'reachability: static', so there
+  /// is no number of steps to compare with
+  if (test->getExecutionResult().status == ExecutionStatus::Invalid) {
+    return 0;
+  }
+  return ExecutionBudget::limitFor(test->getExecutionResult().executionSteps,
+                                   config.getExecutionBudget());
+}
+
+void MutantExecutionTask::runTests(MutationPoint *mutationPoint, Out &storage,
+                                   TestRunner::ObjectFiles *zygoteProgram) {
+  auto atLeastOneTestFailed = false;
+  /// Once a test behaves abnormally in-process, the rest of the tests of this
+  /// mutant go through the regular sandbox
+  auto inProcessAllowed = InProcessSandbox::isSupported();
+  for (auto &reachableTest : mutationPoint->getReachableTests()) {
+    auto test = reachableTest.first;
+    auto distance = reachableTest.second;
+
+    ExecutionResult result;
+    if (config.failFastModeEnabled() && atLeastOneTestFailed) {
+      result.status = ExecutionStatus::FailFast;
+    } else if (zygoteProgram != nullptr &&
+               zygote->runTest(test, testTimeout(test, config),
+                               executionBudget(test), result)) {
+      if (result.status != ExecutionStatus::Passed) {
+        atLeastOneTestFailed = true;
+      }
+    } else {
+      /// The zygote has stopped working: the rest of the tests are run
+      /// against the program linked by the worker itself
+      if (zygoteProgram != nullptr) {
+        runner.loadProgram(*zygoteProgram, jit);
+        zygoteProgram = nullptr;
+      }
+
+      bool runInProcess = inProcessAllowed &&
+                          config.inProcessSandboxEnabledFor(test->getTestName());
+
+      auto runTest = [&]() {
+        /// The budget is shared by all the threads of a process, see
+        /// ExecutionBudget: the tests run in-process are not limited by it
+        if (!runInProcess) {
+          ExecutionBudget::arm(executionBudget(test));
+        }
+        ExecutionStatus status = runner.runTest(test, jit);
+        assert(status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
+        return status;
+      };
+
+      if (runInProcess) {
+        result = inProcessSandbox.run(runTest, testTimeout(test, config));
+
+        /// The abnormal in-process result is not trusted: the test is
+        /// re-run in isolation to get a clean result and the output
+        if (isAbnormal(result.status)) {
+          inProcessAllowed = false;
+          runInProcess = false;
         }
       }
 
-      storage.push_back(make_unique<MutationResult>(result, mutationPoint, distance, test));
+      if (!runInProcess) {
+        result = sandbox.run(runTest, testTimeout(test, config));
+      }
+
+      assert(result.status != ExecutionStatus::Invalid &&
+          "Expect to see valid TestResult");
+
+      if (result.status != ExecutionStatus::Passed) {
+        atLeastOneTestFailed = true;
+      }
+    }
+
+    storage.push_back(make_unique<MutationResult>(result, mutationPoint, distance, test));
+  }
+}
+
+void MutantExecutionTask::runTestsInBatch(MutationPoint *mutationPoint, Out &storage) {
+  auto &reachableTests = mutationPoint->getReachableTests();
+
+  std::vector<Test *> tests;
+  std::vector<int> distances;
+  for (auto &reachableTest : reachableTests) {
+    tests.push_back(reachableTest.first);
+    distances.push_back(reachableTest.second);
+  }
+
+  TestBatch batch(tests, config.failFastModeEnabled());
+  if (!batch.isValid()) {
+    runTests(mutationPoint, storage);
+    return;
+  }
+
+  for (size_t index = 0; index < batch.size(); index++) {
+    batch.setExecutionBudget(index, executionBudget(batch.getTest(index)));
+    /// Only a forked process can restart its timeout
+    if (config.forkEnabled()) {
+      batch.setTimeout(index, testTimeout(batch.getTest(index), config));
     }
   }
+  std::vector<ExecutionResult> results(batch.size());
+
+  size_t first = 0;
+  while (first < batch.size()) {
+    batch.restartFrom(first);
+
+    /// Each test restarts the timeout of the process with its own one,
+    /// so a hanging test does not hold the worker for the whole batch
+    long long timeout = testTimeout(batch.getTest(first), config);
+
+    ExecutionResult batchResult = sandbox.run([&]() {
+      runner.runTests(batch, jit);
+      return ExecutionStatus::Passed;
+    }, timeout);
+
+    size_t current = std::min(batch.getCurrent(), batch.size());
+    for (size_t index = first; index < current; index++) {
+      auto &entry = batch.getEntry(index);
+      results[index].status = entry.status;
+      results[index].runningTime = entry.runningTime;
+    }
+
+    auto atLeastOneTestFailed = false;
+    for (size_t index = first; index < current; index++) {
+      if (results[index].status != ExecutionStatus::Passed) {
+        atLeastOneTestFailed = true;
+      }
+    }
+
+    if (batchResult.status == ExecutionStatus::Passed) {
+      /// The process finished normally, all the output belongs to the last
+      /// test it has run
+      if (current > first) {
+        results[current - 1].exitStatus = batchResult.exitStatus;
+        results[current - 1].stdoutOutput = batchResult.stdoutOutput;
+        results[current - 1].stderrOutput = batchResult.stderrOutput;
+      }
+      first = current;
+    } else {
+      /// The current test crashed, timed out, or exited on its own:
+      /// the batch continues from the next test.
+      /// If the process died after the last test, e.g. while running static
+      /// destructors, then the last test takes the blame.
+      size_t failed = std::min(current, batch.size() - 1);
+      long long runningTimeOfPreviousTests = 0;
+      for (size_t index = first; index < failed; index++) {
+        runningTimeOfPreviousTests += results[index].runningTime;
+      }
+
+      batchResult.runningTime =
+          std::max(0LL, batchResult.runningTime - runningTimeOfPreviousTests);
+      results[failed] = batchResult;
+      atLeastOneTestFailed = true;
+      first = failed + 1;
+    }
+
+    if (config.failFastModeEnabled() && atLeastOneTestFailed) {
+      for (size_t index = first; index < batch.size(); index++) {
+        results[index].status = ExecutionStatus::FailFast;
+      }
+      first = batch.size();
+    }
+  }
+
+  for (size_t index = 0; index < batch.size(); index++) {
+    assert(results[index].status != ExecutionStatus::Invalid &&
+           "Expect to see valid TestResult");
+    storage.push_back(make_unique<MutationResult>(results[index],
+                                                  mutationPoint,
+                                                  distances[index],
+                                                  batch.getTest(index)));
+  }
 }
@@ -1,6 +1,9 @@
 #include "Parallelization/Tasks/OriginalCompilationTask.h"
 #include "Parallelization/Progress.h"
 #include "Toolchain/Toolchain.h"
+#include "Instrumentation/ExecutionBudget.h"
+#include "Instrumentation/SamplingProfiler.h"
+#include "Config.h"
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/Support/TargetSelect.h>
@@ -8,7 +11,8 @@
 using namespace mull;
 using namespace llvm;
 
-OriginalCompilationTask::OriginalCompilationTask(Toolchain &toolchain) : toolchain(toolchain) {}
+OriginalCompilationTask::OriginalCompilationTask(Toolchain &toolchain, Config &config)
+    : toolchain(toolchain), config(config) {}
 
 void mull::OriginalCompilationTask::operator()(mull::OriginalCompilationTask::iterator begin,
                                              mull::OriginalCompilationTask::iterator end,
@@ -26,6 +30,12 @@ void mull::OriginalCompilationTask::operator()(mull::OriginalCompilationTask::it
     if (objectFile.getBinary() == nullptr) {
       LLVMContext localContext;
       auto clonedModule = module.clone(localContext);
+      if (config.executionBudgetEnabled()) {
+        ExecutionBudget::insertCounters(clonedModule->getModule());
+      }
+      if (config.samplingReachabilityEnabled()) {
+        SamplingProfiler::keepFramePointers(clonedModule->getModule());
+      }
       objectFile = toolchain.compiler().compileModule(*clonedModule, *localMachine);
       toolchain.cache().putObject(objectFile, module);
     }
@@ -1,10 +1,12 @@
 #include "Parallelization/Tasks/OriginalTestExecutionTask.h"
 #include "Parallelization/Progress.h"
 #include "Instrumentation/Instrumentation.h"
+#include "Instrumentation/ExecutionBudget.h"
 #include "Toolchain/Toolchain.h"
 #include "ForkProcessSandbox.h"
 #include "TestRunner.h"
 #include "Config.h"
+#include "ReachabilityCache.h"
 
 using namespace mull;
 using namespace llvm;
@@ -14,40 +16,82 @@ OriginalTestExecutionTask::OriginalTestExecutionTask(Instrumentation &instrument
                                                      TestRunner &runner,
                                                      Config &config,
                                                      Filter &filter,
-                                                     JITEngine &jit)
+                                                     JITEngine &jit,
+                                                     ReachabilityCache *cache,
+                                                     const SamplingProfiler *profiler)
     : instrumentation(instrumentation),
       sandbox(sandbox),
       runner(runner),
       config(config),
       filter(filter),
-      jit(jit) {}
+      jit(jit),
+      cache(cache),
+      profiler(profiler),
+      samplingStatistics(profiler ? SamplingProfiler::createStatistics() : nullptr),
+      buffers(),
+      callForest() {}
 
 void OriginalTestExecutionTask::operator()(iterator begin, iterator end, Out &storage,
                                            progress_counter &counter) {
   for (auto it = begin; it != end; ++it, counter.increment()) {
     auto &test = *it;
 
-    instrumentation.setupInstrumentationInfo(test.get());
+    if (cache && cache->restore(test.get(), storage)) {
+      continue;
+    }
 
-    ExecutionResult testExecutionResult = sandbox.run([&]() {
+    if (!buffers) {
+      buffers = instrumentation.createBuffers();
+    }
+    instrumentation.setupInstrumentationInfo(test.get(), *buffers);
+
+    auto runTest = [&]() {
+      ExecutionBudget::arm(0);
       return runner.runTest(test.get(), jit);
-    }, config.getTimeout());
+    };
+
+    ExecutionResult testExecutionResult;
+    if (profiler) {
+      /// The repeated runs must not make the test look slower than it is,
+      /// its running time sets the timeout of the mutants
+      testExecutionResult = sandbox.run([&]() {
+        return profiler->profile(test.get(), runTest, config.getTimeout() / 2,
+                                 *samplingStatistics);
+      }, config.getTimeout());
+      if (testExecutionResult.status == Passed) {
+        testExecutionResult.runningTime = samplingStatistics->runningTime;
+      }
+    } else {
+      testExecutionResult = sandbox.run(runTest, config.getTimeout());
+    }
 
     test->setExecutionResult(testExecutionResult);
 
     std::vector<std::unique_ptr<Testee>> testees;
 
     if (testExecutionResult.status == Passed) {
-      testees = instrumentation.getTestees(test.get(), filter, config.getMaxDistance());
+      testees = instrumentation.getTestees(test.get(), filter,
+                                           config.getMaxDistance(), callForest);
+      instrumentation.recordCallCounts(test.get(), callForest);
+      buffers->setTouchedFunctions(callForest.calledFunctions());
+      buffers->setTouchedBlocks(instrumentation.recordCoveredBlocks(test.get()));
     }
-    instrumentation.cleanupInstrumentationInfo(test.get());
+    instrumentation.cleanupInstrumentationInfo(test.get(), *buffers);
 
-    if (testees.empty()) {
-      continue;
+    if (!testees.empty()) {
+      /// The first testee is the test itself
+      testees.erase(testees.begin());
+    }
+
+    /// Timeouts and crashes may be caused by the environment, rerun them
+    bool deterministic = testExecutionResult.status == Passed ||
+                         testExecutionResult.status == Failed;
+    if (cache && deterministic) {
+      cache->store(test.get(), testees);
     }
 
-    for (auto it = std::next(testees.begin()); it != testees.end(); ++it) {
-      storage.push_back(std::move(*it));
+    for (auto &testee : testees) {
+      storage.push_back(std::move(testee));
     }
   }
 }
@@ -2,39 +2,49 @@
 #include "Parallelization/Tasks/SearchMutationPointsTask.h"
 #include "Filter.h"
 #include "Context.h"
+#include "Test.h"
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/Instruction.h>
 #include <llvm/IR/Module.h>
 
 using namespace mull;
 using namespace llvm;
 
-static int GetFunctionIndex(llvm::Function *function) {
-  Module *parent = function->getParent();
-
-  auto functionIterator = std::find_if(parent->begin(), parent->end(),
-                                       [function] (llvm::Function &f) {
-                                         return &f == function;
-                                       });
-
-  assert(functionIterator != parent->end()
-             && "Expected function to be found in module");
-  int index = static_cast<int>(std::distance(parent->begin(),
-                                             functionIterator));
-
-  return index;
-}
-
-SearchMutationPointsTask::SearchMutationPointsTask(Filter &filter, const Context &context, std::vector<std::unique_ptr<Mutator>> &mutators)
-    : filter(filter), context(context), mutators(mutators) {
+SearchMutationPointsTask::SearchMutationPointsTask(Filter &filter, const Context &context,
+                                                   std::vector<std::unique_ptr<Mutator>> &mutators,
+                                                   bool blockCoverage)
+    : filter(filter), context(context), mutators(mutators), blockCoverage(blockCoverage),
+      mutatorsByOpcode(Instruction::OtherOpsEnd), anyOpcodeMutators() {
+  for (size_t index = 0; index < mutators.size(); index++) {
+    auto opcodes = mutators[index]->getOpcodes();
+    if (opcodes.empty()) {
+      anyOpcodeMutators.push_back(index);
+      continue;
+    }
 
+    for (unsigned opcode : opcodes) {
+      assert(opcode < mutatorsByOpcode.size() && "Unknown opcode");
+      auto &opcodeMutators = mutatorsByOpcode[opcode];
+      if (std::find(opcodeMutators.begin(), opcodeMutators.end(), index) == opcodeMutators.end()) {
+        opcodeMutators.push_back(index);
+      }
+    }
+  }
 }
 
 void SearchMutationPointsTask::operator()(iterator begin,
                                           iterator end,
                                           std::vector<std::unique_ptr<MutationPoint>> &storage,
                                           progress_counter &counter) {
+  /// The points are collected per mutator and stored in the order of the
+  /// mutators, the same order a separate walk for each mutator would give
+  std::vector<std::vector<MutationPoint *>> mutatorPoints(mutators.size());
+  std::vector<size_t> instructionMutators;
+
   for (auto it = begin; it != end; it++, counter.increment()) {
     auto &testee = *it;
     Function *function = testee.getTesteeFunction();
@@ -42,34 +52,70 @@ void SearchMutationPointsTask::operator()(iterator begin,
     auto moduleID = function->getParent()->getModuleIdentifier();
     MullModule *module = context.moduleWithIdentifier(moduleID);
 
-    int functionIndex = GetFunctionIndex(function);
-    for (auto &mutator : mutators) {
+    int functionIndex = module->getFunctionIndex(function);
+    auto reachableTests = testee.shareReachableTests();
 
-      int basicBlockIndex = 0;
-      for (auto &basicBlock : function->getBasicBlockList()) {
+    /// With block coverage each block gets its own subset of the row,
+    /// computed once for all the mutators
+    std::vector<std::shared_ptr<const ReachableTests>> blockReachableTests;
+    if (blockCoverage) {
+      blockReachableTests.resize(function->getBasicBlockList().size());
+    }
 
-        int instructionIndex = 0;
-        for (auto &instruction : basicBlock.getInstList()) {
-          if (filter.shouldSkipInstruction(&instruction)) {
-            instructionIndex++;
-            continue;
-          }
+    int basicBlockIndex = 0;
+    for (auto &basicBlock : function->getBasicBlockList()) {
+
+      int instructionIndex = 0;
+      for (auto &instruction : basicBlock.getInstList()) {
+        auto &opcodeMutators = mutatorsByOpcode[instruction.getOpcode()];
+        if (opcodeMutators.empty() && anyOpcodeMutators.empty()) {
+          instructionIndex++;
+          continue;
+        }
 
-          auto location = SourceLocation::sourceLocationFromInstruction(&instruction);
+        if (filter.shouldSkipInstruction(&instruction)) {
+          instructionIndex++;
+          continue;
+        }
 
-          MutationPointAddress address(functionIndex, basicBlockIndex, instructionIndex);
+        instructionMutators.clear();
+        std::merge(opcodeMutators.begin(), opcodeMutators.end(),
+                   anyOpcodeMutators.begin(), anyOpcodeMutators.end(),
+                   std::back_inserter(instructionMutators));
+
+        auto location = SourceLocation::sourceLocationFromInstruction(&instruction);
+        MutationPointAddress address(functionIndex, basicBlockIndex, instructionIndex);
+
+        for (size_t mutatorIndex : instructionMutators) {
+          auto &mutator = mutators[mutatorIndex];
           MutationPoint *point = mutator->getMutationPoint(module, address, &instruction, location);
-          if (point) {
-            for (auto &reachableTest : testee.getReachableTests()) {
-              point->addReachableTest(reachableTest.first, reachableTest.second);
+          if (!point) {
+            continue;
+          }
+
+          if (blockCoverage) {
+            auto &blockTests = blockReachableTests[basicBlockIndex];
+            if (!blockTests) {
+              blockTests = reachableTests->filter([&](Test *test) {
+                return test->coversBlock(&basicBlock);
+              });
             }
-            storage.emplace_back(std::unique_ptr<MutationPoint>(point));
+            point->setReachableTests(blockTests);
+          } else {
+            point->setReachableTests(reachableTests);
           }
-          instructionIndex++;
+          mutatorPoints[mutatorIndex].push_back(point);
         }
-        basicBlockIndex++;
+        instructionIndex++;
       }
+      basicBlockIndex++;
+    }
+
+    for (auto &points : mutatorPoints) {
+      for (auto point : points) {
+        storage.emplace_back(std::unique_ptr<MutationPoint>(point));
+      }
+      points.clear();
     }
   }
 }
-
@@ -0,0 +1,37 @@
+#include "Parallelization/Tasks/TestDiscoveryTask.h"
+#include "Parallelization/Progress.h"
+#include "Context.h"
+#include "TestDiscoveryCache.h"
+
+#include <llvm/IR/Function.h>
+
+using namespace mull;
+using namespace llvm;
+
+TestDiscoveryTask::TestDiscoveryTask(ModuleTestFinder &finder,
+                                     const TestDiscoveryCache *cache)
+    : finder(finder), cache(cache) {}
+
+void TestDiscoveryTask::operator()(iterator begin, iterator end, Out &storage,
+                                   progress_counter &counter) {
+  for (auto it = begin; it != end; ++it, counter.increment()) {
+    DiscoveredModuleTests tests;
+    tests.module = it->get();
+
+    if (cache && cache->restore(tests)) {
+      storage.push_back(std::move(tests));
+      continue;
+    }
+
+    Module *module = tests.module->getModule();
+    tests.tests = finder.discoverTests(module);
+    for (auto constructor : Context::getStaticConstructors(module)) {
+      tests.constructors.push_back(constructor->getName().str());
+    }
+
+    if (cache) {
+      cache->store(tests);
+    }
+    storage.push_back(std::move(tests));
+  }
+}
@@ -0,0 +1,138 @@
+#include "PatternMatcher.h"
+#include "Logger.h"
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/Regex.h>
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+
+using namespace mull;
+using namespace llvm;
+
+const char *const PatternMatcher::RegexPrefix = "regex:";
+
+static const int NoNode = -1;
+
+PatternMatcher::PatternMatcher() : nodes(1), regexes() {
+  nodes[0].failure = 0;
+  nodes[0].terminal = false;
+}
+
+PatternMatcher::~PatternMatcher() = default;
+
+int PatternMatcher::child(int node, char character) const {
+  auto &children = nodes[node].children;
+  auto position = std::lower_bound(children.begin(), children.end(),
+                                   std::make_pair(character, 0),
+                                   [](const std::pair<char, int> &lhs,
+                                      const std::pair<char, int> &rhs) {
+                                     return lhs.first < rhs.first;
+                                   });
+  if (position == children.end() || position->first != character) {
+    return NoNode;
+  }
+  return position->second;
+}
+
+void PatternMatcher::addPattern(const std::string &pattern) {
+  StringRef patternRef(pattern);
+  if (patternRef.startswith(RegexPrefix)) {
+    auto regex = llvm::make_unique<Regex>(patternRef.drop_front(strlen(RegexPrefix)));
+    std::string error;
+    if (!regex->isValid(error)) {
+      Logger::error() << "Invalid regular expression '" << pattern
+                      << "': " << error << "\n";
+      return;
+    }
+    regexes.push_back(std::move(regex));
+    return;
+  }
+
+  int node = 0;
+  for (char character : pattern) {
+    int next = child(node, character);
+    if (next == NoNode) {
+      next = static_cast<int>(nodes.size());
+      nodes.push_back(Node());
+      nodes.back().failure = 0;
+      nodes.back().terminal = false;
+
+      auto &children = nodes[node].children;
+      auto position = std::lower_bound(children.begin(), children.end(),
+                                       std::make_pair(character, 0));
+      children.insert(position, std::make_pair(character, next));
+    }
+    node = next;
+  }
+  nodes[node].terminal = true;
+
+  /// The patterns are added before any text is matched,
+  /// hence the links are simply recomputed for the whole trie
+  computeFailureLinks();
+}
+
+/// A failure link points to the node of the longest proper suffix of the
+/// node's string that is in the trie. A node is terminal when any of its
+/// suffixes is a pattern, so matching does not need to follow the links
+/// to find out.
+void PatternMatcher::computeFailureLinks() {
+  std::queue<int> queue;
+  for (auto &edge : nodes[0].children) {
+    nodes[edge.second].failure = 0;
+    queue.push(edge.second);
+  }
+
+  while (!queue.empty()) {
+    int node = queue.front();
+    queue.pop();
+
+    for (auto &edge : nodes[node].children) {
+      int failure = nodes[node].failure;
+      while (failure != 0 && child(failure, edge.first) == NoNode) {
+        failure = nodes[failure].failure;
+      }
+      int next = child(failure, edge.first);
+      nodes[edge.second].failure = next != NoNode ? next : 0;
+      if (nodes[nodes[edge.second].failure].terminal) {
+        nodes[edge.second].terminal = true;
+      }
+      queue.push(edge.second);
+    }
+  }
+}
+
+bool PatternMatcher::empty() const {
+  return nodes[0].children.empty() && !nodes[0].terminal && regexes.empty();
+}
+
+bool PatternMatcher::matches(StringRef text) const {
+  /// An empty substring is contained in any text
+  if (nodes[0].terminal) {
+    return true;
+  }
+
+  if (!nodes[0].children.empty()) {
+    int node = 0;
+    for (char character : text) {
+      int next = child(node, character);
+      while (next == NoNode && node != 0) {
+        node = nodes[node].failure;
+        next = child(node, character);
+      }
+      node = next != NoNode ? next : 0;
+      if (nodes[node].terminal) {
+        return true;
+      }
+    }
+  }
+
+  for (auto &regex : regexes) {
+    if (regex->match(text)) {
+      return true;
+    }
+  }
+
+  return false;
+}
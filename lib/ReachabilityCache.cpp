@@ -0,0 +1,264 @@
+#include "ReachabilityCache.h"
+
+#include "Config.h"
+#include "Context.h"
+#include "Logger.h"
+#include "Test.h"
+#include "Testee.h"
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace mull;
+using namespace llvm;
+
+/// Everything the call trees and the original results depend on
+static std::string programHash(Config &config, Context &context) {
+  std::vector<std::string> modules;
+  for (auto &module : context.getModules()) {
+    modules.push_back(module->getUniqueIdentifier());
+  }
+  std::sort(modules.begin(), modules.end());
+
+  MD5 hasher;
+  for (auto &module : modules) {
+    hasher.update(module);
+    hasher.update(" ");
+  }
+  hasher.update(config.getTestFramework());
+  for (auto &location : config.getExcludeLocations()) {
+    hasher.update(" ");
+    hasher.update(location);
+  }
+  std::ostringstream options;
+  options << " " << config.getMaxDistance()
+          << " " << config.getTimeout()
+          << " " << config.blockCoverageEnabled()
+          << " " << config.callCountsEnabled()
+          << " " << config.executionBudgetEnabled()
+          << " " << Config::reachabilityModeToString(config.getReachabilityMode());
+  hasher.update(options.str());
+
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return result.c_str();
+}
+
+ReachabilityCache::ReachabilityCache(Config &config, Context &context)
+    : path(config.getCacheDirectory() + "/reachability_" +
+           programHash(config, context)),
+      entries(), modified(false), mutex(), functionsByKey(), blockIndices() {
+  for (auto &module : context.getModules()) {
+    for (auto &function : module->getModule()->getFunctionList()) {
+      if (function.isDeclaration()) {
+        continue;
+      }
+      functionsByKey[functionKey(&function)] = &function;
+
+      if (config.blockCoverageEnabled()) {
+        uint32_t index = 0;
+        for (auto &block : function) {
+          blockIndices[&block] = index++;
+        }
+      }
+    }
+  }
+
+  read();
+}
+
+std::string ReachabilityCache::functionKey(Function *function) const {
+  return function->getParent()->getModuleIdentifier() + "\t" +
+         function->getName().str();
+}
+
+void ReachabilityCache::read() {
+  std::ifstream file(path);
+  if (!file) {
+    return;
+  }
+
+  Entry *entry = nullptr;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    std::string kind;
+    fields >> kind;
+
+    if (kind == "T") {
+      int status = 0;
+      Entry newEntry;
+      fields >> status >> newEntry.result.exitStatus
+             >> newEntry.result.runningTime >> newEntry.result.executionSteps;
+      newEntry.result.status = static_cast<ExecutionStatus>(status);
+
+      std::string identifier;
+      fields.get();
+      std::getline(fields, identifier);
+      entry = &(entries[identifier] = newEntry);
+      continue;
+    }
+
+    if (entry == nullptr || (kind != "F" && kind != "B" && kind != "C")) {
+      Logger::warn() << "Skipping malformed reachability cache " << path << "\n";
+      entries.clear();
+      return;
+    }
+
+    uint64_t number = 0;
+    std::string key;
+    fields >> number;
+    fields.get();
+    std::getline(fields, key);
+
+    auto function = functionsByKey.find(key);
+    if (function == functionsByKey.end()) {
+      /// The function is gone: the entry cannot be trusted anymore.
+      /// Same for the blocks below.
+      entry->result.status = ExecutionStatus::Invalid;
+      continue;
+    }
+
+    if (kind == "F") {
+      entry->functions.emplace_back(function->second, number);
+      continue;
+    }
+
+    if (kind == "C") {
+      entry->callCounts.emplace_back(function->second, number);
+      continue;
+    }
+
+    auto block = function->second->begin();
+    for (uint64_t index = 0; index < number && block != function->second->end();
+         index++) {
+      ++block;
+    }
+    if (block == function->second->end()) {
+      entry->result.status = ExecutionStatus::Invalid;
+      continue;
+    }
+    entry->blocks.push_back(&*block);
+  }
+
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (it->second.result.status == ExecutionStatus::Invalid) {
+      it = entries.erase(it);
+    } else {
+      std::sort(it->second.blocks.begin(), it->second.blocks.end());
+      std::sort(it->second.callCounts.begin(), it->second.callCounts.end());
+      ++it;
+    }
+  }
+}
+
+bool ReachabilityCache::containsAll(
+    const std::vector<std::unique_ptr<Test>> &tests) const {
+  for (auto &test : tests) {
+    if (entries.count(test->getUniqueIdentifier()) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ReachabilityCache::restore(Test *test,
+                                std::vector<std::unique_ptr<Testee>> &testees) const {
+  /// Other workers store their entries meanwhile
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = entries.find(test->getUniqueIdentifier());
+  if (it == entries.end()) {
+    return false;
+  }
+
+  auto &entry = it->second;
+  test->setExecutionResult(entry.result);
+  test->setCoveredBlocks(entry.blocks);
+  test->setCallCounts(entry.callCounts);
+  for (auto &function : entry.functions) {
+    testees.push_back(make_unique<Testee>(function.first, test, function.second));
+  }
+  return true;
+}
+
+void ReachabilityCache::store(Test *test,
+                              const std::vector<std::unique_ptr<Testee>> &testees) {
+  Entry entry;
+  entry.result = test->getExecutionResult();
+  /// The output is only shown for the failed mutants, no need to keep it
+  entry.result.stdoutOutput.clear();
+  entry.result.stderrOutput.clear();
+  for (auto &testee : testees) {
+    entry.functions.emplace_back(testee->getTesteeFunction(), testee->getDistance());
+  }
+  entry.blocks = test->getCoveredBlocks();
+  entry.callCounts = test->getCallCounts();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  entries[test->getUniqueIdentifier()] = std::move(entry);
+  modified = true;
+}
+
+void ReachabilityCache::save() {
+  if (!modified) {
+    return;
+  }
+
+  auto directory = sys::path::parent_path(path);
+  if (sys::fs::create_directories(directory)) {
+    Logger::warn() << "Cannot create cache directory " << directory << "\n";
+    return;
+  }
+
+  /// Written to a uniquely named file next to the final one and then renamed,
+  /// so that a concurrent or interrupted run never sees a partial file
+  SmallString<128> temporaryPath;
+  if (sys::fs::createUniqueFile(path + ".%%%%%%", temporaryPath)) {
+    Logger::warn() << "Cannot create a temporary file for reachability cache "
+                   << path << "\n";
+    return;
+  }
+  {
+    std::ofstream file(temporaryPath.c_str(), std::ios::trunc);
+    for (auto &it : entries) {
+      auto &result = it.second.result;
+      file << "T " << int(result.status) << " " << result.exitStatus << " "
+           << result.runningTime << " " << result.executionSteps << " "
+           << it.first << "\n";
+      for (auto &function : it.second.functions) {
+        file << "F " << function.second << " "
+             << functionKey(function.first) << "\n";
+      }
+      for (auto block : it.second.blocks) {
+        file << "B " << blockIndices[block] << " "
+             << functionKey(block->getParent()) << "\n";
+      }
+      for (auto &count : it.second.callCounts) {
+        file << "C " << count.second << " "
+             << functionKey(count.first) << "\n";
+      }
+    }
+    if (!file) {
+      Logger::warn() << "Cannot write reachability cache " << path << "\n";
+      sys::fs::remove(temporaryPath);
+      return;
+    }
+  }
+
+  if (auto error = sys::fs::rename(temporaryPath, path)) {
+    Logger::warn() << "Cannot write reachability cache " << path << ": "
+                   << error.message() << "\n";
+    sys::fs::remove(temporaryPath);
+    return;
+  }
+  modified = false;
+}
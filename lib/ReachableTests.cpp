@@ -0,0 +1,126 @@
+#include "ReachableTests.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace mull;
+
+static size_t countBits(uint64_t word) {
+  return __builtin_popcountll(word);
+}
+
+ReachableTests::iterator::iterator(const ReachableTests &row, size_t testIndex,
+                                   size_t rank)
+    : row(&row), testIndex(testIndex), rank(rank), current(nullptr, 0) {
+  load();
+}
+
+ReachableTests::iterator &ReachableTests::iterator::operator++() {
+  testIndex = row->nextTest(testIndex + 1);
+  rank++;
+  load();
+  return *this;
+}
+
+void ReachableTests::iterator::load() {
+  if (testIndex < row->bits.size() * BitsPerWord) {
+    current = std::make_pair((*row->tests)[testIndex],
+                             int(row->distances[rank]));
+  }
+}
+
+ReachableTests::ReachableTests()
+    : tests(), bits(), distances(), lastTest(0) {}
+
+ReachableTests::ReachableTests(std::shared_ptr<const std::vector<Test *>> tests)
+    : tests(std::move(tests)), bits(), distances(), lastTest(0) {
+  bits.resize((this->tests->size() + BitsPerWord - 1) / BitsPerWord, 0);
+}
+
+void ReachableTests::add(size_t testIndex, int distance) {
+  assert(tests && testIndex < tests->size());
+  assert(distance >= 0);
+
+  uint16_t shortDistance = distance < std::numeric_limits<uint16_t>::max()
+                               ? uint16_t(distance)
+                               : std::numeric_limits<uint16_t>::max();
+
+  /// The tests are usually added in order
+  if (distances.empty() || testIndex > lastTest) {
+    bits[testIndex / BitsPerWord] |= uint64_t(1) << (testIndex % BitsPerWord);
+    distances.push_back(shortDistance);
+    lastTest = testIndex;
+    return;
+  }
+
+  size_t index = rank(testIndex);
+  if (contains(testIndex)) {
+    distances[index] = std::min(distances[index], shortDistance);
+    return;
+  }
+
+  bits[testIndex / BitsPerWord] |= uint64_t(1) << (testIndex % BitsPerWord);
+  distances.insert(distances.begin() + index, shortDistance);
+}
+
+std::shared_ptr<ReachableTests>
+ReachableTests::filter(const std::function<bool(Test *)> &predicate) const {
+  auto filtered = std::make_shared<ReachableTests>();
+  filtered->tests = tests;
+  filtered->bits.resize(bits.size(), 0);
+
+  size_t index = 0;
+  for (size_t test = nextTest(0); test < bits.size() * BitsPerWord;
+       test = nextTest(test + 1), index++) {
+    if (predicate((*tests)[test])) {
+      filtered->bits[test / BitsPerWord] |= uint64_t(1) << (test % BitsPerWord);
+      filtered->distances.push_back(distances[index]);
+      filtered->lastTest = test;
+    }
+  }
+
+  return filtered;
+}
+
+bool ReachableTests::empty() const {
+  return distances.empty();
+}
+
+size_t ReachableTests::size() const {
+  return distances.size();
+}
+
+ReachableTests::iterator ReachableTests::begin() const {
+  return iterator(*this, nextTest(0), 0);
+}
+
+ReachableTests::iterator ReachableTests::end() const {
+  return iterator(*this, bits.size() * BitsPerWord, distances.size());
+}
+
+bool ReachableTests::contains(size_t testIndex) const {
+  return bits[testIndex / BitsPerWord] & (uint64_t(1) << (testIndex % BitsPerWord));
+}
+
+size_t ReachableTests::rank(size_t testIndex) const {
+  size_t word = testIndex / BitsPerWord;
+  size_t count = 0;
+  for (size_t index = 0; index < word; index++) {
+    count += countBits(bits[index]);
+  }
+  uint64_t lowerBits = (uint64_t(1) << (testIndex % BitsPerWord)) - 1;
+  return count + countBits(bits[word] & lowerBits);
+}
+
+size_t ReachableTests::nextTest(size_t testIndex) const {
+  size_t end = bits.size() * BitsPerWord;
+  while (testIndex < end) {
+    uint64_t word = bits[testIndex / BitsPerWord] >> (testIndex % BitsPerWord);
+    if (word != 0) {
+      return testIndex + __builtin_ctzll(word);
+    }
+    testIndex = (testIndex / BitsPerWord + 1) * BitsPerWord;
+  }
+  return end;
+}
@@ -139,14 +139,19 @@ void mull::SQLiteReporter::reportResults(const Result &result,
     sqlite3_reset(insertTestStmt);
   }
 
-  const char *insertMutationResultQuery = "INSERT INTO mutation_result VALUES (?1, ?2, ?3)";
+  const char *insertMutationResultQuery = "INSERT INTO mutation_result VALUES (?1, ?2, ?3, ?4)";
   sqlite3_stmt *insertMutationResultStmt;
   sqlite3_prepare(database, insertMutationResultQuery, -1, &insertMutationResultStmt, nullptr);
 
   for (auto &mutationResult : result.getMutationResults()) {
     MutationPoint *mutationPoint = mutationResult->getMutationPoint();
-    std::string testId = mutationResult->getTest()->getUniqueIdentifier();
+    /// Mutants not covered by any test have no test
+    Test *test = mutationResult->getTest();
+    std::string testId = test ? test->getUniqueIdentifier() : "";
     std::string pointId = mutationPoint->getUniqueIdentifier();
+    /// How hot the mutated code is for the test, see 'call_counts'
+    Function *mutatedFunction = cast<Instruction>(mutationPoint->getOriginalValue())->getFunction();
+    uint64_t callCount = test ? test->getCallCount(mutatedFunction) : 0;
 
     ExecutionResult mutationExecutionResult = mutationResult->getExecutionResult();
 
@@ -166,6 +171,7 @@ void mull::SQLiteReporter::reportResults(const Result &result,
     sqlite3_bind_text(insertMutationResultStmt, mutationResultIndex++, testId.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(insertMutationResultStmt, mutationResultIndex++, pointId.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(insertMutationResultStmt, mutationResultIndex++, mutationResult->getMutationDistance());
+    sqlite3_bind_int64(insertMutationResultStmt, mutationResultIndex++, callCount);
 
     sqlite3_step(insertMutationResultStmt);
     sqlite3_clear_bindings(insertMutationResultStmt);
@@ -282,6 +288,52 @@ void mull::SQLiteReporter::reportResults(const Result &result,
     sqlite3_step(insertConfigStmt);
   }
 
+  /// Sampling, see 'sampling' option. The seed and the strata are enough to
+  /// draw the same sample again.
+  if (auto sampler = result.getSampler()) {
+    const char *insertSamplingQuery = "INSERT INTO sampling VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)";
+    sqlite3_stmt *insertSamplingStmt;
+    sqlite3_prepare(database, insertSamplingQuery, -1, &insertSamplingStmt, NULL);
+
+    auto estimate = sampler->estimate();
+    size_t sampleSize = 0;
+    for (auto &stratum : sampler->getStrata()) {
+      sampleSize += stratum.sampleSize;
+    }
+
+    int index = 1;
+    sqlite3_bind_int64(insertSamplingStmt, index++, sampler->getSeed());
+    sqlite3_bind_int64(insertSamplingStmt, index++, sampler->getPopulation());
+    sqlite3_bind_int64(insertSamplingStmt, index++, sampleSize);
+    sqlite3_bind_int64(insertSamplingStmt, index++, estimate.executed);
+    sqlite3_bind_double(insertSamplingStmt, index++, estimate.score);
+    sqlite3_bind_double(insertSamplingStmt, index++, estimate.lower);
+    sqlite3_bind_double(insertSamplingStmt, index++, estimate.upper);
+
+    sqlite3_step(insertSamplingStmt);
+
+    const char *insertStratumQuery = "INSERT INTO sampling_stratum VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)";
+    sqlite3_stmt *insertStratumStmt;
+    sqlite3_prepare(database, insertStratumQuery, -1, &insertStratumStmt, NULL);
+
+    for (auto &stratum : sampler->getStrata()) {
+      double weight = double(stratum.population) / sampler->getPopulation();
+
+      int index = 1;
+      sqlite3_bind_text(insertStratumStmt, index++, stratum.mutator.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(insertStratumStmt, index++, stratum.module.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_int64(insertStratumStmt, index++, stratum.population);
+      sqlite3_bind_int64(insertStratumStmt, index++, stratum.sampleSize);
+      sqlite3_bind_int64(insertStratumStmt, index++, stratum.executed);
+      sqlite3_bind_int64(insertStratumStmt, index++, stratum.killed);
+      sqlite3_bind_double(insertStratumStmt, index++, weight);
+
+      sqlite3_step(insertStratumStmt);
+      sqlite3_clear_bindings(insertStratumStmt);
+      sqlite3_reset(insertStratumStmt);
+    }
+  }
+
   sqlite_exec(database, "END TRANSACTION");
 
   sqlite3_close(database);
@@ -326,7 +378,8 @@ CREATE TABLE mutation_point (
 CREATE TABLE mutation_result (
   test_id TEXT,
   mutation_point_id TEXT,
-  mutation_distance INT
+  mutation_distance INT,
+  call_count INT
 );
 
 CREATE TABLE mutation_point_debug (
@@ -357,6 +410,26 @@ CREATE TABLE config (
   time_start INT,
   time_end INT
 );
+
+CREATE TABLE sampling (
+  seed INT,
+  population INT,
+  sample_size INT,
+  executed INT,
+  score REAL,
+  score_lower REAL,
+  score_upper REAL
+);
+
+CREATE TABLE sampling_stratum (
+  mutator TEXT,
+  module_name TEXT,
+  population INT,
+  sample_size INT,
+  executed INT,
+  killed INT,
+  weight REAL
+);
 )CreateTables";
 
 static void createTables(sqlite3 *database) {
@@ -0,0 +1,108 @@
+#include "RunPlanner.h"
+
+#include "MullModule.h"
+#include "MutantCostModel.h"
+#include "MutationPoint.h"
+#include "Mutators/Mutator.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+using namespace mull;
+
+/// Share of the time left a chunk may take, see RunPlanner::nextChunk
+static const double ChunkTimeShare = 0.25;
+
+RunPlanner::RunPlanner(const std::vector<MutationPoint *> &points,
+                       MutantCostModel &costModel, int workers)
+    : plan(), handedOut(points.size(), false), workers(std::max(1, workers)),
+      chunkCost(0), predictedCost(0), elapsedTime(0) {
+  std::map<std::pair<std::string, std::string>, size_t> strata;
+  for (auto point : points) {
+    auto key = std::make_pair(point->getMutator()->getUniqueIdentifier(),
+                              point->getOriginalModule()->getModule()->getModuleIdentifier());
+    auto stratum = strata.insert(std::make_pair(key, strata.size())).first->second;
+    plan.push_back({ point, costModel.cost(point), stratum, 0 });
+  }
+
+  /// Cheapest first within a stratum...
+  std::stable_sort(plan.begin(), plan.end(),
+                   [](const PlannedMutant &lhs, const PlannedMutant &rhs) {
+                     if (lhs.stratum != rhs.stratum) {
+                       return lhs.stratum < rhs.stratum;
+                     }
+                     return lhs.cost < rhs.cost;
+                   });
+  for (size_t i = 1; i < plan.size(); i++) {
+    if (plan[i].stratum == plan[i - 1].stratum) {
+      plan[i].rank = plan[i - 1].rank + 1;
+    }
+  }
+
+  /// ...and a round over all the strata before the next one
+  std::stable_sort(plan.begin(), plan.end(),
+                   [](const PlannedMutant &lhs, const PlannedMutant &rhs) {
+                     if (lhs.rank != rhs.rank) {
+                       return lhs.rank < rhs.rank;
+                     }
+                     return lhs.cost < rhs.cost;
+                   });
+}
+
+std::vector<MutationPoint *> RunPlanner::nextChunk(double remainingTime,
+                                                   size_t chunkSize) {
+  std::vector<MutationPoint *> chunk;
+  double calibration = getCalibration();
+  double chunkTime = 0;
+  double chunkTimeLimit = remainingTime * ChunkTimeShare;
+  chunkCost = 0;
+
+  /// A mutant that does not fit is skipped, the cheaper ones after it may
+  /// still fit
+  for (size_t i = 0; i < plan.size() && chunk.size() < chunkSize; i++) {
+    if (handedOut[i]) {
+      continue;
+    }
+    double time = plan[i].cost / workers * calibration;
+    if (chunkTime + time > remainingTime) {
+      continue;
+    }
+    /// Otherwise a mutant longer than the limit would never run
+    if (!chunk.empty() && chunkTime + time > chunkTimeLimit) {
+      continue;
+    }
+    chunkTime += time;
+    chunkCost += plan[i].cost;
+    handedOut[i] = true;
+    chunk.push_back(plan[i].point);
+  }
+
+  return chunk;
+}
+
+void RunPlanner::calibrate(double chunkElapsedTime) {
+  if (chunkCost <= 0) {
+    return;
+  }
+  predictedCost += chunkCost / workers;
+  elapsedTime += chunkElapsedTime;
+  chunkCost = 0;
+}
+
+double RunPlanner::getCalibration() const {
+  if (predictedCost <= 0 || elapsedTime <= 0) {
+    return 1;
+  }
+  return elapsedTime / predictedCost;
+}
+
+std::vector<MutationPoint *> RunPlanner::remaining() const {
+  std::vector<MutationPoint *> points;
+  for (size_t i = 0; i < plan.size(); i++) {
+    if (!handedOut[i]) {
+      points.push_back(plan[i].point);
+    }
+  }
+  return points;
+}
@@ -11,25 +11,34 @@
 using namespace mull;
 using namespace llvm;
 
-std::vector<std::unique_ptr<Test>> SimpleTestFinder::findTests(Context &context,
-                                                               Filter &filter) {
-  std::vector<std::unique_ptr<Test>> tests;
+SimpleTestFinder::SimpleTestFinder(int workers, const std::string &cacheDirectory)
+    : ModuleTestFinder(workers, cacheDirectory) {}
 
-  for (auto &module : context.getModules()) {
-    auto &x = module->getModule()->getFunctionList();
-    for (auto &Fn : x) {
+std::string SimpleTestFinder::discoveryKey() const {
+  return "SimpleTest";
+}
 
-      /// We find C functions having test_ and the same functions if they are
-      /// compiled with C++ (mangled as "_Z25test_").
-      if (Fn.getName().find("test_") != std::string::npos) {
+std::vector<DiscoveredTest> SimpleTestFinder::discoverTests(Module *module) {
+  std::vector<DiscoveredTest> tests;
 
-        Logger::info() << "SimpleTestFinder::findTests - found function "
-                       << Fn.getName() << '\n';
+  for (auto &Fn : module->getFunctionList()) {
 
-        tests.emplace_back(make_unique<SimpleTest_Test>(&Fn));
-      }
+    /// We find C functions having test_ and the same functions if they are
+    /// compiled with C++ (mangled as "_Z25test_").
+    if (Fn.getName().find("test_") != std::string::npos) {
+      tests.emplace_back(Fn.getName().str(), Fn.getName().str());
     }
   }
 
   return tests;
 }
+
+std::unique_ptr<Test>
+SimpleTestFinder::createTest(const DiscoveredTest &test, Function *entryPoint,
+                             const std::vector<Function *> &constructors,
+                             Filter &filter) {
+  Logger::info() << "SimpleTestFinder::findTests - found function "
+                 << entryPoint->getName() << '\n';
+
+  return make_unique<SimpleTest_Test>(entryPoint);
+}
@@ -1,6 +1,7 @@
 #include "SimpleTest/SimpleTestRunner.h"
 #include "SimpleTest/SimpleTest_Test.h"
 
+#include "Instrumentation/Callbacks.h"
 #include "Toolchain/Resolvers/InstrumentationResolver.h"
 #include "Toolchain/Resolvers/NativeResolver.h"
 #include "Mangler.h"
@@ -49,7 +50,7 @@ void SimpleTestRunner::loadProgram(ObjectFiles &objectFiles, JITEngine &jit) {
 }
 
 ExecutionStatus SimpleTestRunner::runTest(Test *test, JITEngine &jit) {
-  *trampoline = &test->getInstrumentationInfo();
+  Callbacks::setInstrumentationInfo(trampoline, &test->getInstrumentationInfo());
   assert(isa<SimpleTest_Test>(test) && "Supposed to work only with");
 
   SimpleTest_Test *SimpleTest = dyn_cast<SimpleTest_Test>(test);
@@ -0,0 +1,238 @@
+#include "StaticCallGraph.h"
+
+#include "Context.h"
+#include "Filter.h"
+#include "Test.h"
+
+#include <llvm/IR/CallSite.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <queue>
+
+using namespace mull;
+using namespace llvm;
+
+/// Pointers are erased: the types are compared across modules and a virtual
+/// call passes 'this' as a pointer to the base class
+static std::string signatureOf(FunctionType *type) {
+  std::string signature;
+  raw_string_ostream stream(signature);
+
+  auto print = [&](Type *type) {
+    if (type->isPointerTy()) {
+      stream << "ptr";
+    } else {
+      type->print(stream);
+    }
+  };
+
+  print(type->getReturnType());
+  stream << "(";
+  for (Type *parameter : type->params()) {
+    print(parameter);
+    stream << ",";
+  }
+  if (type->isVarArg()) {
+    stream << "...";
+  }
+  stream << ")";
+
+  return stream.str();
+}
+
+StaticCallGraph::StaticCallGraph(Context &context)
+    : context(context), callees(), indirectTargets(), roots() {
+  for (auto &module : context.getModules()) {
+    for (auto &function : module->getModule()->getFunctionList()) {
+      if (!function.hasAddressTaken()) {
+        continue;
+      }
+      Function *definition = definitionOf(&function);
+      if (definition == nullptr) {
+        continue;
+      }
+      auto signature = signatureOf(definition->getFunctionType());
+      indirectTargets[signature].push_back(definition);
+      if (addressEscapes(&function)) {
+        roots.push_back(definition);
+      }
+    }
+  }
+
+  for (auto &targets : indirectTargets) {
+    auto &functions = targets.second;
+    std::sort(functions.begin(), functions.end());
+    functions.erase(std::unique(functions.begin(), functions.end()),
+                    functions.end());
+  }
+  std::sort(roots.begin(), roots.end());
+  roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+
+  for (auto &module : context.getModules()) {
+    for (auto &function : module->getModule()->getFunctionList()) {
+      if (!function.isDeclaration()) {
+        addCalls(function);
+      }
+    }
+  }
+}
+
+/// The address is passed to a function defined outside of the loaded modules.
+/// The functions stored in globals, vtables included, are not roots: the
+/// indirect calls reaching them are resolved by signature.
+bool StaticCallGraph::addressEscapes(Value *address) {
+  for (auto user : address->users()) {
+    if (auto expression = dyn_cast<ConstantExpr>(user)) {
+      /// The address cast to the type of the parameter
+      if (expression->isCast() && addressEscapes(expression)) {
+        return true;
+      }
+      continue;
+    }
+
+    CallSite callSite(user);
+    if (!callSite || callSite.isInlineAsm()) {
+      continue;
+    }
+    auto callee = dyn_cast<Function>(callSite.getCalledValue()->stripPointerCasts());
+    if (callee == nullptr || callee->isIntrinsic()) {
+      continue;
+    }
+    if (definitionOf(callee) != nullptr) {
+      continue;
+    }
+    for (auto &argument : callSite.args()) {
+      if (argument.get() == address) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+Function *StaticCallGraph::definitionOf(Function *function) {
+  if (!function->isDeclaration()) {
+    return function;
+  }
+  if (function->isIntrinsic()) {
+    return nullptr;
+  }
+  return context.lookupDefinedFunction(function->getName());
+}
+
+void StaticCallGraph::addCalls(Function &function) {
+  auto &functionCallees = callees[&function];
+
+  for (auto &block : function) {
+    for (auto &instruction : block) {
+      CallSite callSite(&instruction);
+      if (!callSite || callSite.isInlineAsm()) {
+        continue;
+      }
+
+      Value *calledValue = callSite.getCalledValue()->stripPointerCasts();
+      if (auto callee = dyn_cast<Function>(calledValue)) {
+        if (auto definition = definitionOf(callee)) {
+          functionCallees.push_back(definition);
+        }
+        continue;
+      }
+
+      auto signature = signatureOf(callSite.getFunctionType());
+      auto targets = indirectTargets.find(signature);
+      if (targets != indirectTargets.end()) {
+        functionCallees.insert(functionCallees.end(),
+                               targets->second.begin(), targets->second.end());
+      }
+    }
+  }
+
+  std::sort(functionCallees.begin(), functionCallees.end());
+  functionCallees.erase(std::unique(functionCallees.begin(),
+                                    functionCallees.end()),
+                        functionCallees.end());
+}
+
+const std::vector<Function *> &StaticCallGraph::getCallees(Function *function) {
+  return callees[function];
+}
+
+std::vector<std::unique_ptr<Testee>>
+StaticCallGraph::getTestees(Test *test, Filter &filter, int maxDistance) {
+  std::vector<std::unique_ptr<Testee>> testees;
+
+  std::unordered_map<Function *, int> distances;
+  std::queue<Function *> functions;
+  for (auto entryPoint : test->entryPoints()) {
+    if (distances.emplace(entryPoint, 0).second) {
+      functions.push(entryPoint);
+    }
+  }
+  if (maxDistance > 0) {
+    for (auto root : roots) {
+      if (distances.emplace(root, 1).second) {
+        functions.push(root);
+      }
+    }
+  }
+
+  while (!functions.empty()) {
+    Function *function = functions.front();
+    functions.pop();
+    int distance = distances[function];
+
+    if (distance != 0) {
+      if (filter.shouldSkipFunction(function)) {
+        continue;
+      }
+      testees.push_back(make_unique<Testee>(function, test, distance));
+    }
+
+    if (distance >= maxDistance) {
+      continue;
+    }
+    for (auto callee : getCallees(function)) {
+      if (distances.emplace(callee, distance + 1).second) {
+        functions.push(callee);
+      }
+    }
+  }
+
+  return testees;
+}
+
+std::unordered_set<Function *> StaticCallGraph::reachableFunctions(
+    const std::vector<std::unique_ptr<Test>> &tests) {
+  std::unordered_set<Function *> reachable;
+  std::vector<Function *> functions;
+
+  for (auto &test : tests) {
+    for (auto entryPoint : test->entryPoints()) {
+      if (reachable.insert(entryPoint).second) {
+        functions.push_back(entryPoint);
+      }
+    }
+  }
+  for (auto root : roots) {
+    if (reachable.insert(root).second) {
+      functions.push_back(root);
+    }
+  }
+
+  while (!functions.empty()) {
+    Function *function = functions.back();
+    functions.pop_back();
+    for (auto callee : getCallees(function)) {
+      if (reachable.insert(callee).second) {
+        functions.push_back(callee);
+      }
+    }
+  }
+
+  return reachable;
+}
@@ -0,0 +1,104 @@
+#include "TestBatch.h"
+
+#include "Logger.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/types.h>
+
+using namespace mull;
+
+TestBatch::TestBatch(std::vector<Test *> tests, bool stopAfterFailure)
+    : tests(std::move(tests)), executionBudgets(this->tests.size(), 0),
+      timeouts(this->tests.size(), 0), stopAfterFailure(stopAfterFailure), first(0), sharedSize(0),
+      shared(nullptr) {
+  assert(!this->tests.empty() && "Batch must have at least one test");
+
+  sharedSize = sizeof(SharedState) +
+               sizeof(TestBatchEntry) * (this->tests.size() - 1);
+
+  /// Creating a memory to be shared between child and parent.
+  auto rawMemory = mmap(nullptr, sharedSize,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS,
+                        -1, 0);
+  if (rawMemory == MAP_FAILED) {
+    Logger::error() << "Cannot allocate memory for a batch of "
+                    << this->tests.size() << " tests: " << strerror(errno) << "\n";
+    return;
+  }
+  shared = static_cast<SharedState *>(rawMemory);
+  restartFrom(0);
+}
+
+TestBatch::~TestBatch() {
+  if (shared != nullptr) {
+    munmap(shared, sharedSize);
+  }
+}
+
+bool TestBatch::isValid() const {
+  return shared != nullptr;
+}
+
+size_t TestBatch::size() const {
+  return tests.size();
+}
+
+Test *TestBatch::getTest(size_t index) const {
+  return tests[index];
+}
+
+size_t TestBatch::getFirst() const {
+  return first;
+}
+
+void TestBatch::restartFrom(size_t index) {
+  first = index;
+  shared->current = index;
+  for (size_t i = index; i < tests.size(); i++) {
+    setEntry(i, ExecutionStatus::Invalid, 0);
+  }
+}
+
+size_t TestBatch::getCurrent() const {
+  return shared->current;
+}
+
+void TestBatch::setCurrent(size_t index) {
+  shared->current = index;
+}
+
+TestBatchEntry &TestBatch::getEntry(size_t index) {
+  assert(index < tests.size());
+  return shared->entries[index];
+}
+
+void TestBatch::setEntry(size_t index, ExecutionStatus status,
+                         long long runningTime) {
+  TestBatchEntry &entry = getEntry(index);
+  entry.status = status;
+  entry.runningTime = runningTime;
+}
+
+bool TestBatch::shouldStopAfterFailure() const {
+  return stopAfterFailure;
+}
+
+uint64_t TestBatch::getExecutionBudget(size_t index) const {
+  return executionBudgets[index];
+}
+
+void TestBatch::setExecutionBudget(size_t index, uint64_t budget) {
+  executionBudgets[index] = budget;
+}
+
+long long TestBatch::getTimeout(size_t index) const {
+  return timeouts[index];
+}
+
+void TestBatch::setTimeout(size_t index, long long timeout) {
+  timeouts[index] = timeout;
+}
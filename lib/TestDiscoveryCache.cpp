@@ -0,0 +1,96 @@
+#include "TestDiscoveryCache.h"
+
+#include "Logger.h"
+#include "MullModule.h"
+#include "TestFinder.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace mull;
+using namespace llvm;
+
+TestDiscoveryCache::TestDiscoveryCache(const std::string &directory,
+                                       const std::string &key)
+    : directory(directory), key(key) {}
+
+std::string TestDiscoveryCache::pathForModule(MullModule *module) const {
+  MD5 hasher;
+  hasher.update(module->getUniqueIdentifier());
+  hasher.update(" ");
+  hasher.update(key);
+
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return directory + "/tests_" + result.c_str();
+}
+
+bool TestDiscoveryCache::restore(DiscoveredModuleTests &tests) const {
+  std::string path = pathForModule(tests.module);
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+
+  DiscoveredModuleTests restored;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    std::string kind;
+    std::string function;
+    fields >> kind >> function;
+
+    if (kind == "C" && !function.empty()) {
+      restored.constructors.push_back(function);
+      continue;
+    }
+
+    if (kind == "T" && !function.empty()) {
+      std::string name;
+      fields.get();
+      std::getline(fields, name);
+      restored.tests.emplace_back(name, function);
+      continue;
+    }
+
+    Logger::warn() << "Skipping malformed test cache " << path << "\n";
+    return false;
+  }
+
+  tests.tests = std::move(restored.tests);
+  tests.constructors = std::move(restored.constructors);
+  return true;
+}
+
+void TestDiscoveryCache::store(const DiscoveredModuleTests &tests) const {
+  if (sys::fs::create_directories(directory)) {
+    Logger::warn() << "Cannot create cache directory " << directory << "\n";
+    return;
+  }
+
+  /// Written next to the final file and then renamed, so that a concurrent
+  /// or interrupted run never sees a partial file
+  std::string path = pathForModule(tests.module);
+  std::string temporaryPath = path + ".tmp";
+  {
+    std::ofstream file(temporaryPath, std::ios::trunc);
+    for (auto &constructor : tests.constructors) {
+      file << "C " << constructor << "\n";
+    }
+    for (auto &test : tests.tests) {
+      file << "T " << test.entryPoint << " " << test.name << "\n";
+    }
+    if (!file) {
+      Logger::warn() << "Cannot write test cache " << path << "\n";
+      return;
+    }
+  }
+
+  std::rename(temporaryPath.c_str(), path.c_str());
+}
@@ -0,0 +1,58 @@
+#include "TestFinder.h"
+
+#include "Context.h"
+#include "Parallelization/Parallelization.h"
+#include "TestDiscoveryCache.h"
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+
+using namespace mull;
+using namespace llvm;
+
+ModuleTestFinder::ModuleTestFinder(int workers, const std::string &cacheDirectory)
+    : workers(workers), cacheDirectory(cacheDirectory) {}
+
+std::vector<std::unique_ptr<Test>> ModuleTestFinder::findTests(Context &context,
+                                                               Filter &filter) {
+  std::unique_ptr<TestDiscoveryCache> cache;
+  if (!cacheDirectory.empty()) {
+    cache = make_unique<TestDiscoveryCache>(cacheDirectory, discoveryKey());
+  }
+
+  std::vector<DiscoveredModuleTests> discovered;
+  std::vector<TestDiscoveryTask> tasks;
+  for (int i = 0; i < workers; i++) {
+    tasks.emplace_back(*this, cache.get());
+  }
+  TaskExecutor<TestDiscoveryTask> finder("Searching tests",
+                                         context.getModules(), discovered,
+                                         std::move(tasks));
+  finder.execute();
+
+  std::vector<Function *> constructors;
+  for (auto &moduleTests : discovered) {
+    Module *module = moduleTests.module->getModule();
+    for (auto &name : moduleTests.constructors) {
+      if (auto constructor = module->getFunction(name)) {
+        constructors.push_back(constructor);
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<Test>> tests;
+  for (auto &moduleTests : discovered) {
+    Module *module = moduleTests.module->getModule();
+    for (auto &discoveredTest : moduleTests.tests) {
+      Function *entryPoint = module->getFunction(discoveredTest.entryPoint);
+      assert(entryPoint && "The test was discovered in a different module");
+
+      auto test = createTest(discoveredTest, entryPoint, constructors, filter);
+      if (test) {
+        tests.push_back(std::move(test));
+      }
+    }
+  }
+
+  return tests;
+}
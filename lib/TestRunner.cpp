@@ -1,5 +1,7 @@
 #include "TestRunner.h"
 
+#include "Logger.h"
+
 #include <llvm/Support/DynamicLibrary.h>
 
 using namespace mull;
@@ -10,3 +12,12 @@ TestRunner::TestRunner(llvm::TargetMachine &targetMachine)
 {
   sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
 }
+
+bool TestRunner::supportsBatchExecution() const {
+  return false;
+}
+
+void TestRunner::runTests(TestBatch &batch, JITEngine &jit) {
+  Logger::error() << "The test runner does not support batch execution\n";
+  exit(1);
+}
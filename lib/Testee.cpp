@@ -1,51 +1,56 @@
 #include "Testee.h"
 
+#include <unordered_map>
+
 namespace mull {
 std::vector<MergedTestee> mergeTestees(std::vector<std::unique_ptr<Testee>> &testees) {
-  std::map<llvm::Function *, MergedTestee> testeesMap;
+  /// Columns and rows of the matrix, in the order of the first appearance
+  auto tests = std::make_shared<std::vector<Test *>>();
+  std::unordered_map<Test *, size_t> testIndices;
+  std::vector<llvm::Function *> functions;
+  std::unordered_map<llvm::Function *, size_t> functionIndices;
 
   for (auto &testee : testees) {
+    if (testIndices.emplace(testee->getTest(), tests->size()).second) {
+      tests->push_back(testee->getTest());
+    }
     auto function = testee->getTesteeFunction();
-    auto test = testee->getTest();
-    auto distance = testee->getDistance();
-    auto merged = testeesMap.find(function);
-    if (merged != testeesMap.end()) {
-      merged->second.addReachableTest(test, distance);
-    } else {
-      testeesMap.insert(std::make_pair(function, MergedTestee(function, test, distance)));
+    if (functionIndices.emplace(function, functions.size()).second) {
+      functions.push_back(function);
     }
   }
 
+  std::vector<std::shared_ptr<ReachableTests>> rows;
+  rows.reserve(functions.size());
+  for (size_t index = 0; index < functions.size(); index++) {
+    rows.push_back(std::make_shared<ReachableTests>(tests));
+  }
+
+  for (auto &testee : testees) {
+    auto &row = rows[functionIndices[testee->getTesteeFunction()]];
+    row->add(testIndices[testee->getTest()], testee->getDistance());
+  }
+
   std::vector<MergedTestee> mergedTestees;
-  for (auto &testee: testees) {
-    /// TODO: We could have just accumulated contents from the map,
-    /// But it would break the order of mutants: some of our tests depend on it
-    if (testeesMap.empty()) {
-      break;
-    }
-    auto function = testee->getTesteeFunction();
-    auto mergedTestee = testeesMap.find(function);
-    if (mergedTestee != testeesMap.end()) {
-      mergedTestees.push_back((*mergedTestee).second);
-      testeesMap.erase(mergedTestee);
-    }
+  mergedTestees.reserve(functions.size());
+  for (size_t index = 0; index < functions.size(); index++) {
+    mergedTestees.emplace_back(functions[index], std::move(rows[index]));
   }
 
   return mergedTestees;
 }
 }
 
-mull::MergedTestee::MergedTestee(llvm::Function *function, mull::Test *test, int distance)
-    : function(function)
-{
-  addReachableTest(test, distance);
-}
+mull::MergedTestee::MergedTestee(llvm::Function *function,
+                                 std::shared_ptr<ReachableTests> reachableTests)
+    : reachableTests(std::move(reachableTests)), function(function) {}
 
-void mull::MergedTestee::addReachableTest(mull::Test *test, int distance) {
-  reachableTests.emplace_back(test, distance);
+const mull::ReachableTests &mull::MergedTestee::getReachableTests() const {
+  return *reachableTests;
 }
 
-const std::vector<std::pair<mull::Test *, int>> &mull::MergedTestee::getReachableTests() const {
+std::shared_ptr<const mull::ReachableTests>
+mull::MergedTestee::shareReachableTests() const {
   return reachableTests;
 }
 
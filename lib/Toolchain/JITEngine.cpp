@@ -56,3 +56,6 @@ llvm_compat::JITSymbol &JITEngine::getSymbol(llvm::StringRef name) {
   return symbolIterator->second;
 }
 
+const std::vector<object::ObjectFile *> &JITEngine::getObjectFiles() const {
+  return objectFiles;
+}
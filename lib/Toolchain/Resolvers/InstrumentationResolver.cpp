@@ -17,6 +17,7 @@ InstrumentationResolver::InstrumentationResolver(orc::LocalCXXRuntimeOverrides &
 instrumentation(instrumentation),
 instrumentationInfoName(mangler.getNameWithPrefix(instrumentation.instrumentationInfoVariableName())),
 functionOffsetPrefix(mangler.getNameWithPrefix(instrumentation.functionIndexOffsetPrefix())),
+blockOffsetPrefix(mangler.getNameWithPrefix(instrumentation.blockIndexOffsetPrefix())),
 trampoline(trampoline) {}
 
 llvm_compat::JITSymbolInfo InstrumentationResolver::findSymbol(const std::string &name) {
@@ -40,6 +41,12 @@ llvm_compat::JITSymbolInfo InstrumentationResolver::findSymbol(const std::string
     return llvm_compat::JITSymbolInfo((uint64_t)&mapping[moduleName], JITSymbolFlags::Exported);
   }
 
+  if (name.find(blockOffsetPrefix) != std::string::npos) {
+    auto moduleName = name.substr(blockOffsetPrefix.length());
+    auto &mapping = instrumentation.getBlockOffsetMapping();
+    return llvm_compat::JITSymbolInfo((uint64_t)&mapping[moduleName], JITSymbolFlags::Exported);
+  }
+
   return llvm_compat::JITSymbolInfo(nullptr);
 }
 
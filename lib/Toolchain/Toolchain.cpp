@@ -8,6 +8,28 @@
 
 using namespace mull;
 
+static std::string cacheDirectory(Config &config) {
+  std::string directory = config.getCacheDirectory();
+  /// Object files with execution budget counters or with different
+  /// instrumentation must not be mixed with the regular ones
+  if (config.executionBudgetEnabled()) {
+    directory += "/execution_budget";
+  }
+  if (config.blockCoverageEnabled()) {
+    directory += "/block_coverage";
+  }
+  if (config.callCountsEnabled()) {
+    directory += "/call_counts";
+  }
+  if (config.inlineInstrumentationEnabled()) {
+    directory += "/inline_instrumentation";
+  }
+  if (config.samplingReachabilityEnabled()) {
+    directory += "/frame_pointers";
+  }
+  return directory;
+}
+
 /// To make sure that initialization is getting called
 /// before we create TargetMachine
 /// Otherwise we cannot selectTarget, which lead us to invalid TargetMachine
@@ -21,7 +43,7 @@ Toolchain::Toolchain(Config &config) :
   nativeTarget(),
   machine(llvm::EngineBuilder().selectTarget(llvm::Triple(), "", "",
                                          llvm::SmallVector<std::string, 1>())),
-  objectCache(config.cachingEnabled(), config.getCacheDirectory()),
+  objectCache(config.cachingEnabled(), cacheDirectory(config)),
   simpleCompiler()
 {
 }
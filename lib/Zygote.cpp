@@ -0,0 +1,555 @@
+#include "Zygote.h"
+
+#include "ForkProcessSandbox.h"
+#include "Logger.h"
+#include "TestRunner.h"
+#include "Instrumentation/ExecutionBudget.h"
+#include "Toolchain/JITEngine.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <csignal>
+#include <set>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace mull;
+using namespace llvm;
+using namespace llvm::object;
+
+namespace {
+
+enum class RequestKind : uint32_t {
+  LoadObjectFile = 1,
+  ReleaseObjectFile,
+  LoadProgram,
+  RunTest,
+  UnloadProgram,
+  Shutdown
+};
+
+struct Request {
+  RequestKind kind;
+  uint32_t count;
+  uint64_t argument;
+  int64_t timeout;
+  uint64_t executionBudget;
+};
+
+struct Response {
+  int32_t status;
+  int32_t exitStatus;
+  int64_t runningTime;
+  uint64_t executionSteps;
+  uint64_t stdoutSize;
+  uint64_t stderrSize;
+};
+
+}
+
+#if defined(MSG_NOSIGNAL)
+/// A dead peer must be reported as an error rather than kill Mull by SIGPIPE
+static const int SendFlags = MSG_NOSIGNAL;
+#else
+static const int SendFlags = 0;
+#endif
+
+/// Mull's ends of the sockets of all the running zygotes. A newly forked zygote
+/// closes them, so that each zygote sees the end of its own stream as soon as
+/// Mull goes away.
+static std::set<int> openSockets;
+
+static Request makeRequest(RequestKind kind) {
+  Request request;
+  memset(&request, 0, sizeof(request));
+  request.kind = kind;
+  return request;
+}
+
+static bool writeAll(int fd, const void *data, size_t size) {
+  const char *bytes = static_cast<const char *>(data);
+  while (size > 0) {
+    ssize_t written = send(fd, bytes, size, SendFlags);
+    if (written == -1 && errno == ENOTSOCK) {
+      written = write(fd, bytes, size);
+    }
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= written;
+  }
+  return true;
+}
+
+static bool readAll(int fd, void *data, size_t size) {
+  char *bytes = static_cast<char *>(data);
+  while (size > 0) {
+    ssize_t received = read(fd, bytes, size);
+    if (received == -1 && errno == EINTR) {
+      continue;
+    }
+    if (received == 0) {
+      /// The other side is gone, there is no error to report
+      errno = 0;
+      return false;
+    }
+    if (received == -1) {
+      return false;
+    }
+    bytes += received;
+    size -= received;
+  }
+  return true;
+}
+
+/// Sends the request with an optional file descriptor attached to it
+static bool sendRequest(int socket, const Request &request, int fd = -1) {
+  if (fd == -1) {
+    return writeAll(socket, &request, sizeof(request));
+  }
+
+  struct iovec vector;
+  vector.iov_base = const_cast<Request *>(&request);
+  vector.iov_len = sizeof(request);
+
+  char control[CMSG_SPACE(sizeof(int))];
+  memset(control, 0, sizeof(control));
+
+  struct msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_iov = &vector;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+  header->cmsg_level = SOL_SOCKET;
+  header->cmsg_type = SCM_RIGHTS;
+  header->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(header), &fd, sizeof(int));
+
+  ssize_t sent = -1;
+  do {
+    sent = sendmsg(socket, &message, SendFlags);
+  } while (sent == -1 && errno == EINTR);
+
+  if (sent == -1) {
+    return false;
+  }
+
+  /// The descriptor goes with the first byte, the rest is plain data
+  const char *bytes = reinterpret_cast<const char *>(&request);
+  return writeAll(socket, bytes + sent, sizeof(request) - sent);
+}
+
+/// Receives the request and the file descriptor attached to it, if any.
+/// Returns false once the other side is gone.
+static bool receiveRequest(int socket, Request &request, int &fd) {
+  fd = -1;
+  char *bytes = reinterpret_cast<char *>(&request);
+  size_t size = sizeof(request);
+  while (size > 0) {
+    struct iovec vector;
+    vector.iov_base = bytes;
+    vector.iov_len = size;
+
+    char control[CMSG_SPACE(sizeof(int))];
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &vector;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t received = recvmsg(socket, &message, 0);
+    if (received == -1 && errno == EINTR) {
+      continue;
+    }
+    if (received <= 0) {
+      return false;
+    }
+
+    for (struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+         header != nullptr;
+         header = CMSG_NXTHDR(&message, header)) {
+      if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+        memcpy(&fd, CMSG_DATA(header), sizeof(int));
+      }
+    }
+
+    bytes += received;
+    size -= received;
+  }
+  return true;
+}
+
+static bool sendResult(int socket, const ExecutionResult &result) {
+  Response response;
+  memset(&response, 0, sizeof(response));
+  response.status = result.status;
+  response.exitStatus = result.exitStatus;
+  response.runningTime = result.runningTime;
+  response.executionSteps = result.executionSteps;
+  response.stdoutSize = result.stdoutOutput.size();
+  response.stderrSize = result.stderrOutput.size();
+
+  return writeAll(socket, &response, sizeof(response)) &&
+         writeAll(socket, result.stdoutOutput.data(), response.stdoutSize) &&
+         writeAll(socket, result.stderrOutput.data(), response.stderrSize);
+}
+
+static bool receiveResult(int socket, ExecutionResult &result) {
+  Response response;
+  if (!readAll(socket, &response, sizeof(response))) {
+    return false;
+  }
+
+  result.status = static_cast<ExecutionStatus>(response.status);
+  result.exitStatus = response.exitStatus;
+  result.runningTime = response.runningTime;
+  result.executionSteps = response.executionSteps;
+  result.stdoutOutput.resize(response.stdoutSize);
+  result.stderrOutput.resize(response.stderrSize);
+
+  return readAll(socket, &result.stdoutOutput[0], response.stdoutSize) &&
+         readAll(socket, &result.stderrOutput[0], response.stderrSize);
+}
+
+static OwningBinary<ObjectFile> readObjectFile(int fd) {
+  struct stat info;
+  if (fstat(fd, &info) == -1) {
+    return OwningBinary<ObjectFile>();
+  }
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> buffer =
+      MemoryBuffer::getOpenFile(fd, "zygote-object", info.st_size, false);
+  if (!buffer) {
+    return OwningBinary<ObjectFile>();
+  }
+
+  Expected<std::unique_ptr<ObjectFile>> objectOrError =
+      ObjectFile::createObjectFile(buffer.get()->getMemBufferRef());
+  if (!objectOrError) {
+    consumeError(objectOrError.takeError());
+    return OwningBinary<ObjectFile>();
+  }
+
+  return OwningBinary<ObjectFile>(std::move(objectOrError.get()),
+                                  std::move(buffer.get()));
+}
+
+#pragma mark - Zygote and host processes
+
+/// Links the program once and runs the requested tests against it until
+/// the program is unloaded.
+static void hostMain(int socket, TestRunner &runner,
+                     TestRunner::ObjectFiles &objectFiles) {
+  JITEngine jit;
+  runner.loadProgram(objectFiles, jit);
+
+  uint32_t loaded = 1;
+  if (!writeAll(socket, &loaded, sizeof(loaded))) {
+    _exit(0);
+  }
+
+  ForkProcessSandbox sandbox;
+  Request request;
+  int fd = -1;
+  while (receiveRequest(socket, request, fd)) {
+    if (fd != -1) {
+      close(fd);
+    }
+
+    if (request.kind == RequestKind::UnloadProgram) {
+      _exit(0);
+    }
+    if (request.kind != RequestKind::RunTest) {
+      _exit(1);
+    }
+
+    Test *test = reinterpret_cast<Test *>(static_cast<uintptr_t>(request.argument));
+    uint64_t executionBudget = request.executionBudget;
+    ExecutionResult result = sandbox.run([&]() {
+      ExecutionBudget::arm(executionBudget);
+      return runner.runTest(test, jit);
+    }, request.timeout);
+
+    if (!sendResult(socket, result)) {
+      _exit(0);
+    }
+  }
+  _exit(0);
+}
+
+/// Keeps the received object files and forks a host per program.
+/// The zygote itself never runs any code under test.
+static void zygoteMain(int socket, TestRunner &runner) {
+  std::map<uint64_t, OwningBinary<ObjectFile>> objectFiles;
+
+  Request request;
+  int fd = -1;
+  while (receiveRequest(socket, request, fd)) {
+    switch (request.kind) {
+      case RequestKind::LoadObjectFile: {
+        OwningBinary<ObjectFile> objectFile = readObjectFile(fd);
+        close(fd);
+        if (objectFile.getBinary() == nullptr) {
+          _exit(1);
+        }
+        objectFiles[request.argument] = std::move(objectFile);
+      } break;
+
+      case RequestKind::ReleaseObjectFile:
+        objectFiles.erase(request.argument);
+        break;
+
+      case RequestKind::LoadProgram: {
+        std::vector<uint64_t> ids(request.count);
+        if (!readAll(socket, ids.data(), ids.size() * sizeof(uint64_t))) {
+          _exit(0);
+        }
+
+        TestRunner::ObjectFiles program;
+        for (uint64_t id : ids) {
+          auto it = objectFiles.find(id);
+          if (it == objectFiles.end()) {
+            _exit(1);
+          }
+          program.push_back(it->second.getBinary());
+        }
+
+        const pid_t hostPID = fork();
+        if (hostPID == -1) {
+          _exit(1);
+        }
+        if (hostPID == 0) {
+          hostMain(socket, runner, program);
+        }
+
+        int status = 0;
+        while (waitpid(hostPID, &status, 0) == -1 && errno == EINTR) {}
+
+        /// The host exits normally on 'unloadProgram' only. Otherwise Mull
+        /// waits for a reply nobody is going to send, hence the zygote leaves
+        /// as well to let Mull know something went wrong.
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+          _exit(1);
+        }
+      } break;
+
+      case RequestKind::Shutdown:
+        _exit(0);
+
+      default:
+        _exit(1);
+    }
+  }
+  _exit(0);
+}
+
+#pragma mark - Zygote
+
+Zygote::Zygote(TestRunner &runner)
+    : socket(-1), pid(-1), nextObjectFileId(0) {
+  int sockets[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == -1) {
+    failed("create a socket pair");
+    return;
+  }
+
+#if defined(SO_NOSIGPIPE)
+  int noSignal = 1;
+  setsockopt(sockets[0], SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+  setsockopt(sockets[1], SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+#endif
+
+  /// Otherwise the buffered output is printed by both processes
+  fflush(stdout);
+  fflush(stderr);
+
+  pid = fork();
+  if (pid == -1) {
+    failed("fork");
+    close(sockets[0]);
+    close(sockets[1]);
+    return;
+  }
+
+  if (pid == 0) {
+    for (int openSocket : openSockets) {
+      close(openSocket);
+    }
+    close(sockets[0]);
+    zygoteMain(sockets[1], runner);
+  }
+
+  close(sockets[1]);
+  socket = sockets[0];
+  openSockets.insert(socket);
+}
+
+Zygote::~Zygote() {
+  if (isRunning()) {
+    sendRequest(socket, makeRequest(RequestKind::Shutdown));
+  }
+  shutDown();
+}
+
+bool Zygote::isRunning() const {
+  return socket != -1;
+}
+
+/// The zygote is of no use once a request is lost: it is stopped, and the
+/// tests are run without it from now on
+void Zygote::failed(const char *action) {
+  int error = errno;
+  Logger::warn() << "Zygote: failed to " << action;
+  if (error != 0) {
+    Logger::warn() << ": " << strerror(error);
+  }
+  Logger::warn() << ", running the tests without it\n";
+
+  if (pid > 0) {
+    kill(pid, SIGKILL);
+  }
+  shutDown();
+}
+
+void Zygote::shutDown() {
+  if (socket != -1) {
+    close(socket);
+    openSockets.erase(socket);
+    socket = -1;
+  }
+
+  if (pid > 0) {
+    int status = 0;
+    while (waitpid(pid, &status, 0) == -1 && errno == EINTR) {}
+    pid = -1;
+  }
+  objectFileIds.clear();
+}
+
+bool Zygote::sendObjectFile(ObjectFile *objectFile, uint64_t &id) {
+  int fd = -1;
+  SmallString<64> path;
+  if (sys::fs::createTemporaryFile("mull-zygote", "o", fd, path)) {
+    failed("create a temporary file");
+    return false;
+  }
+  /// The file lives as long as there is a descriptor pointing to it
+  sys::fs::remove(path);
+
+  StringRef data = objectFile->getData();
+  if (!writeAll(fd, data.data(), data.size())) {
+    failed("write an object file");
+    close(fd);
+    return false;
+  }
+
+  Request request = makeRequest(RequestKind::LoadObjectFile);
+  request.argument = nextObjectFileId++;
+  if (!sendRequest(socket, request, fd)) {
+    failed("send an object file");
+    close(fd);
+    return false;
+  }
+  close(fd);
+
+  objectFileIds[objectFile] = request.argument;
+  id = request.argument;
+  return true;
+}
+
+bool Zygote::loadProgram(const std::vector<ObjectFile *> &objectFiles) {
+  if (!isRunning()) {
+    return false;
+  }
+
+  std::vector<uint64_t> ids;
+  for (ObjectFile *objectFile : objectFiles) {
+    auto it = objectFileIds.find(objectFile);
+    if (it != objectFileIds.end()) {
+      ids.push_back(it->second);
+      continue;
+    }
+
+    uint64_t id = 0;
+    if (!sendObjectFile(objectFile, id)) {
+      return false;
+    }
+    ids.push_back(id);
+  }
+
+  Request request = makeRequest(RequestKind::LoadProgram);
+  request.count = ids.size();
+  if (!sendRequest(socket, request) ||
+      !writeAll(socket, ids.data(), ids.size() * sizeof(uint64_t))) {
+    failed("send a program");
+    return false;
+  }
+
+  uint32_t loaded = 0;
+  if (!readAll(socket, &loaded, sizeof(loaded)) || loaded != 1) {
+    failed("load a program");
+    return false;
+  }
+  return true;
+}
+
+bool Zygote::runTest(Test *test, long long timeoutMilliseconds,
+                     uint64_t executionBudget, ExecutionResult &result) {
+  if (!isRunning()) {
+    return false;
+  }
+
+  Request request = makeRequest(RequestKind::RunTest);
+  request.argument = reinterpret_cast<uintptr_t>(test);
+  request.timeout = timeoutMilliseconds;
+  request.executionBudget = executionBudget;
+  if (!sendRequest(socket, request)) {
+    failed("send a test");
+    return false;
+  }
+
+  if (!receiveResult(socket, result)) {
+    failed("run a test");
+    return false;
+  }
+  return true;
+}
+
+void Zygote::unloadProgram() {
+  if (!isRunning()) {
+    return;
+  }
+  if (!sendRequest(socket, makeRequest(RequestKind::UnloadProgram))) {
+    failed("unload a program");
+  }
+}
+
+void Zygote::releaseObjectFile(ObjectFile *objectFile) {
+  auto it = objectFileIds.find(objectFile);
+  if (it == objectFileIds.end()) {
+    return;
+  }
+
+  Request request = makeRequest(RequestKind::ReleaseObjectFile);
+  request.argument = it->second;
+  objectFileIds.erase(it);
+  if (!sendRequest(socket, request)) {
+    failed("release an object file");
+  }
+}
@@ -94,6 +94,12 @@ int main(int argc, char *argv[]) {
   std::unique_ptr<TestFinder> testFinder;
   std::unique_ptr<TestRunner> testRunner;
 
+  int discoveryWorkers = config.parallelization().workers;
+  std::string discoveryCache;
+  if (config.cachingEnabled()) {
+    discoveryCache = config.getCacheDirectory();
+  }
+
   auto mutatorsFactory = MutatorsFactory();
   auto mutators = mutatorsFactory.mutators(config.getMutators());
   MutationsFinder mutationsFinder(std::move(mutators), config);
@@ -108,17 +114,18 @@ int main(int argc, char *argv[]) {
     filter.skipByLocation("gtest");
     filter.skipByLocation("gmock");
 
-    testFinder = make_unique<GoogleTestFinder>();
+    testFinder = make_unique<GoogleTestFinder>(discoveryWorkers, discoveryCache);
     testRunner = make_unique<GoogleTestRunner>(toolchain.targetMachine());
   }
 
   else if (testFramework == "SimpleTest") {
-    testFinder = make_unique<SimpleTestFinder>();
+    testFinder = make_unique<SimpleTestFinder>(discoveryWorkers, discoveryCache);
     testRunner = make_unique<SimpleTestRunner>(toolchain.targetMachine());
   }
 
   else if (testFramework == "CustomTest") {
-    testFinder = make_unique<CustomTestFinder>(config.getCustomTests());
+    testFinder = make_unique<CustomTestFinder>(config.getCustomTests(),
+                                               discoveryWorkers, discoveryCache);
     testRunner = make_unique<CustomTestRunner>(toolchain.targetMachine());
   }
 
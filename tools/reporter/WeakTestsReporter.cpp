@@ -101,10 +101,11 @@ private:
 static std::set<std::string> fetchKilledMutants(const std::string &reportPath) {
   sqlite3 *database;
   sqlite3_open(reportPath.c_str(), &database);
+  /// Neither Passed (2), NotCovered (8), nor Skipped (9) kills a mutant
   const char *query = R"query(
   select mutation_point_id from execution_result
   where
-  mutation_point_id <> "" and status <> 2
+  mutation_point_id <> "" and status not in (2, 8, 9)
   group by mutation_point_id;
 )query";
 
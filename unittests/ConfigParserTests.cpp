@@ -167,6 +167,59 @@ TEST_F(ConfigParserTestFixture, loadConfig_objectFileList_nonExistingFile) {
   ASSERT_EQ(errors.size(), 1U);
 }
 
+TEST_F(ConfigParserTestFixture, loadConfig_executionBudget_requiresFork) {
+  const std::string bitcodeFileList = "/tmp/bitcode_file.list";
+
+  std::ofstream bitcodeFileStream(bitcodeFileList);
+  if (!bitcodeFileStream) {
+    std::cerr << "Cannot open the output file." << std::endl;
+    ASSERT_FALSE(true);
+  }
+
+  const char *configYAML =
+    "bitcode_file_list: /tmp/bitcode_file.list\n"
+    "execution_budget: 10\n"
+    "fork: disabled\n";
+
+  configWithYamlContent(configYAML);
+
+  auto errors = config.validate();
+  ASSERT_EQ(errors.size(), 1U);
+
+  configWithYamlContent("bitcode_file_list: /tmp/bitcode_file.list\n"
+                        "execution_budget: 10\n");
+  ASSERT_EQ(config.validate().size(), 0U);
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_zygote_excludesBatchTestsAndInProcessSandbox) {
+  const std::string bitcodeFileList = "/tmp/bitcode_file.list";
+
+  std::ofstream bitcodeFileStream(bitcodeFileList);
+  if (!bitcodeFileStream) {
+    std::cerr << "Cannot open the output file." << std::endl;
+    ASSERT_FALSE(true);
+  }
+
+  configWithYamlContent("bitcode_file_list: /tmp/bitcode_file.list\n"
+                        "zygote: enabled\n");
+  ASSERT_EQ(config.validate().size(), 0U);
+
+  configWithYamlContent("bitcode_file_list: /tmp/bitcode_file.list\n"
+                        "zygote: enabled\n"
+                        "batch_tests: enabled\n");
+  ASSERT_EQ(config.validate().size(), 1U);
+
+  const char *configYAML = R"YAML(
+bitcode_file_list: /tmp/bitcode_file.list
+zygote: enabled
+in_process_sandbox:
+  tests:
+    - Fast
+  )YAML";
+  configWithYamlContent(configYAML);
+  ASSERT_EQ(config.validate().size(), 1U);
+}
+
 TEST_F(ConfigParserTestFixture, loadConfig_Fork_True) {
   configWithYamlContent("fork: true\n");
   ASSERT_EQ(true, config.forkEnabled());
@@ -242,6 +295,140 @@ TEST_F(ConfigParserTestFixture, loadConfig_FailFast_Disabled) {
   ASSERT_FALSE(config.failFastModeEnabled());
 }
 
+TEST_F(ConfigParserTestFixture, loadConfig_BatchTests_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.batchTestsModeEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_BatchTests_Enabled) {
+  configWithYamlContent("batch_tests: enabled\n");
+  ASSERT_TRUE(config.batchTestsModeEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_BatchTests_Disabled) {
+  configWithYamlContent("batch_tests: disabled\n");
+  ASSERT_FALSE(config.batchTestsModeEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Zygote_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.zygoteEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Zygote_Enabled) {
+  configWithYamlContent("zygote: enabled\n");
+  ASSERT_TRUE(config.zygoteEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Zygote_RequiresFork) {
+  configWithYamlContent("zygote: enabled\n"
+                        "fork: false\n");
+  ASSERT_FALSE(config.zygoteEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_BlockCoverage_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.blockCoverageEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_BlockCoverage_Enabled) {
+  configWithYamlContent("block_coverage: enabled\n");
+  ASSERT_TRUE(config.blockCoverageEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_CallCounts_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.callCountsEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_CallCounts_Enabled) {
+  configWithYamlContent("call_counts: enabled\n");
+  ASSERT_TRUE(config.callCountsEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_CallCounts_RequiresInstrumentation) {
+  configWithYamlContent("call_counts: enabled\n"
+                        "reachability: static\n");
+  ASSERT_FALSE(config.callCountsEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Streaming_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.streamingEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Streaming_Enabled) {
+  configWithYamlContent("streaming: enabled\n");
+  ASSERT_TRUE(config.streamingEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_TimeBudget_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.timeBudgetEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_TimeBudget_SpecificValue) {
+  configWithYamlContent("time_budget: 1200\n");
+  ASSERT_TRUE(config.timeBudgetEnabled());
+  ASSERT_EQ(1200, config.getTimeBudget());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Sampling_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.mutantSamplingEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Sampling) {
+  const char *configYAML = R"YAML(
+sampling:
+  size: 500
+  seed: 42
+  interval_width: 5
+  )YAML";
+  configWithYamlContent(configYAML);
+
+  ASSERT_TRUE(config.mutantSamplingEnabled());
+  ASSERT_EQ(500, config.samplingConfig().size);
+  ASSERT_EQ(42, config.samplingConfig().seed);
+  ASSERT_EQ(5, config.samplingConfig().intervalWidth);
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_InstrumentationMode_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.inlineInstrumentationEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_InstrumentationMode_Inline) {
+  configWithYamlContent("instrumentation_mode: inline\n");
+  ASSERT_TRUE(config.inlineInstrumentationEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Reachability_Unspecified) {
+  configWithYamlContent("");
+  ASSERT_FALSE(config.staticReachabilityEnabled());
+  ASSERT_FALSE(config.hybridReachabilityEnabled());
+  ASSERT_FALSE(config.samplingReachabilityEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Reachability_Static) {
+  configWithYamlContent("reachability: static\n");
+  ASSERT_TRUE(config.staticReachabilityEnabled());
+  ASSERT_FALSE(config.hybridReachabilityEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Reachability_Hybrid) {
+  configWithYamlContent("reachability: hybrid\n");
+  ASSERT_FALSE(config.staticReachabilityEnabled());
+  ASSERT_TRUE(config.hybridReachabilityEnabled());
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_Reachability_Sampling) {
+  configWithYamlContent("reachability: sampling\n");
+  ASSERT_TRUE(config.samplingReachabilityEnabled());
+  ASSERT_FALSE(config.staticReachabilityEnabled());
+  ASSERT_FALSE(config.blockCoverageEnabled());
+}
+
 TEST_F(ConfigParserTestFixture, loadConfig_Diagnostics_Unspecified) {
   configWithYamlContent("");
   ASSERT_EQ(config.getDiagnostics(), Config::Diagnostics::None);
@@ -517,3 +704,35 @@ parallelization:
   ASSERT_EQ(12, parallelization.mutantExecutionWorkers);
   ASSERT_EQ(14, parallelization.testExecutionWorkers);
 }
+
+TEST_F(ConfigParserTestFixture, loadConfig_parallelization_forkDisabled_oneWorker) {
+  const char *configYAML = R"YAML(
+fork: disabled
+parallelization:
+  test_execution_workers: 14
+  mutant_execution_workers: 12
+  )YAML";
+  configWithYamlContent(configYAML);
+
+  auto parallelization = config.parallelization();
+
+  ASSERT_EQ(1, parallelization.mutantExecutionWorkers);
+  ASSERT_EQ(1, parallelization.testExecutionWorkers);
+}
+
+TEST_F(ConfigParserTestFixture, loadConfig_parallelization_inProcessSandbox_oneMutantWorker) {
+  const char *configYAML = R"YAML(
+parallelization:
+  test_execution_workers: 14
+  mutant_execution_workers: 12
+in_process_sandbox:
+  test_frameworks:
+    - GoogleTest
+  )YAML";
+  configWithYamlContent(configYAML);
+
+  auto parallelization = config.parallelization();
+
+  ASSERT_EQ(1, parallelization.mutantExecutionWorkers);
+  ASSERT_EQ(14, parallelization.testExecutionWorkers);
+}
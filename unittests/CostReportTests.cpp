@@ -0,0 +1,94 @@
+#include "CostReport.h"
+#include "MutantCostModel.h"
+#include "MutationPoint.h"
+#include "Mutators/MathAddMutator.h"
+#include "Mutators/MathSubMutator.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Module.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+class CostReportTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+    Function *function = module->getModule()->getFunction("count_letters");
+    ASSERT_NE(nullptr, function);
+    instruction = &*inst_begin(function);
+
+    auto reachable = std::make_shared<std::vector<mull::Test *>>();
+    for (long long runningTime : { 100, 200 }) {
+      tests.push_back(make_unique<SimpleTest_Test>(function));
+      ExecutionResult result;
+      result.status = ExecutionStatus::Passed;
+      result.runningTime = runningTime;
+      tests.back()->setExecutionResult(result);
+      reachable->push_back(tests.back().get());
+    }
+    auto row = std::make_shared<ReachableTests>(reachable);
+    row->add(0, 1);
+    row->add(1, 1);
+    reachableTests = row;
+  }
+
+  MutationPoint *addPoint(Mutator *mutator) {
+    int index = points.size();
+    points.push_back(make_unique<MutationPoint>(mutator,
+                                                MutationPointAddress(0, 0, index),
+                                                instruction, module.get(),
+                                                SourceLocation::nullSourceLocation()));
+    points.back()->setReachableTests(reachableTests);
+    return points.back().get();
+  }
+
+  std::unique_ptr<MullModule> module;
+  Instruction *instruction;
+  std::vector<std::unique_ptr<SimpleTest_Test>> tests;
+  std::shared_ptr<const ReachableTests> reachableTests;
+  std::vector<std::unique_ptr<MutationPoint>> points;
+  MathAddMutator mathAdd;
+  MathSubMutator mathSub;
+};
+
+TEST_F(CostReportTest, failFastSkipsTestsAfterFailure) {
+  auto point = addPoint(&mathAdd);
+
+  MutantCostModel allTests(false);
+  ASSERT_DOUBLE_EQ(300, allTests.executionTime(point));
+
+  MutantCostModel failFast(true);
+  double secondTestRun = 1 - MutantCostModel::TestFailureProbability;
+  ASSERT_DOUBLE_EQ(100 + 200 * secondTestRun, failFast.executionTime(point));
+}
+
+TEST_F(CostReportTest, breaksDownCostAndProjectsWallTime) {
+  std::vector<MutationPoint *> mutants = {
+    addPoint(&mathAdd), addPoint(&mathAdd), addPoint(&mathSub)
+  };
+
+  MutantCostModel costModel;
+  double cost = costModel.cost(mutants.front());
+
+  CostReport report(mutants, costModel, 2);
+  ASSERT_EQ(3U, report.getTotal().mutants);
+  ASSERT_DOUBLE_EQ(3 * cost, report.getTotal().total());
+  ASSERT_DOUBLE_EQ(900, report.getTotal().executionTime);
+
+  ASSERT_EQ(1U, report.getModules().size());
+  ASSERT_EQ(3U, report.getModules().begin()->second.mutants);
+
+  ASSERT_EQ(2U, report.getMutators().size());
+  ASSERT_EQ(2U, report.getMutators().at(mathAdd.getUniqueIdentifier()).mutants);
+  ASSERT_EQ(1U, report.getMutators().at(mathSub.getUniqueIdentifier()).mutants);
+
+  /// Two mutants on the first worker, one on the second
+  ASSERT_DOUBLE_EQ(2 * cost, report.getProjectedWallTime());
+}
@@ -183,6 +183,46 @@ TEST(DynamicCallTree, enter_leave_function) {
   ASSERT_TRUE(stack.empty());
 }
 
+TEST(DynamicCallTree, enter_leave_function_threads) {
+  ///
+  /// Call trace
+  ///
+  ///   Main thread:    F1 -> F2
+  ///   Spawned thread:       F2 -> F3 -> F4
+  ///                               F3 -> F5
+
+  uint32_t mapping[6] = { 0 };
+  std::vector<uint32_t> mainStack;
+  std::vector<uint32_t> threadStack;
+
+  DynamicCallTree::enterFunction(1, mapping, mainStack, 0);
+    DynamicCallTree::enterFunction(2, mapping, mainStack, 0);
+
+      DynamicCallTree::enterFunction(3, mapping, threadStack, mainStack.back());
+        DynamicCallTree::enterFunction(4, mapping, threadStack, 0);
+        DynamicCallTree::leaveFunction(4, mapping, threadStack);
+        DynamicCallTree::enterFunction(5, mapping, threadStack, 0);
+        DynamicCallTree::leaveFunction(5, mapping, threadStack);
+      DynamicCallTree::leaveFunction(3, mapping, threadStack);
+
+    DynamicCallTree::leaveFunction(2, mapping, mainStack);
+  DynamicCallTree::leaveFunction(1, mapping, mainStack);
+
+  ASSERT_EQ(mapping[0], 0UL);
+  ASSERT_EQ(mapping[1], 1UL);
+  ASSERT_EQ(mapping[2], 1UL);
+  ASSERT_EQ(mapping[3], 2UL);
+  ASSERT_EQ(mapping[4], 3UL);
+  ASSERT_EQ(mapping[5], 3UL);
+
+  ASSERT_TRUE(mainStack.empty());
+  ASSERT_TRUE(threadStack.empty());
+
+  /// Unbalanced leave, e.g. after unwinding, is ignored
+  DynamicCallTree::leaveFunction(1, mapping, mainStack);
+  ASSERT_TRUE(mainStack.empty());
+}
+
 TEST(DynamicCallTree, enter_leave_function_recursion) {
 
 #if 0
@@ -387,3 +427,78 @@ TEST(DynamicCallTree, testees) {
     EXPECT_EQ(testeeF4->getDistance(), 1);
   }
 }
+
+static void expectSameTestees(std::vector<std::unique_ptr<Testee>> &expected,
+                              std::vector<std::unique_ptr<Testee>> &actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t index = 0; index < expected.size(); index++) {
+    EXPECT_EQ(expected[index]->getTesteeFunction(),
+              actual[index]->getTesteeFunction());
+    EXPECT_EQ(expected[index]->getDistance(), actual[index]->getDistance());
+  }
+}
+
+TEST(DynamicCallTree, call_forest_matches_call_tree) {
+  Function *phonyFunction = nullptr;
+  Function *F1 = fakeFunction("F1");
+  Function *F2 = fakeFunction("F2");
+  Function *F3 = fakeFunction("F3");
+  Function *F4 = fakeFunction("F4");
+  Function *F5 = fakeFunction("F5");
+  Function *F6 = fakeFunction("F6");
+
+  std::vector<CallTreeFunction> functions;
+  functions.push_back(phonyFunction);
+  functions.push_back(F1);
+  functions.push_back(F2);
+  functions.push_back(F3);
+  functions.push_back(F4);
+  functions.push_back(F5);
+  functions.push_back(F6);
+
+  ///
+  /// Call trace
+  ///
+  ///   F1 -> F2 -> F3
+  ///         F2 -> F4
+  ///   F1 -> F4 -> F5
+  ///   F6 -> F2
+  ///
+
+  uint32_t mapping[7] = {0};
+  mapping[1] = 1;
+  mapping[2] = 1;
+  mapping[3] = 2;
+  mapping[4] = 2;
+  mapping[5] = 4;
+  mapping[6] = 6;
+
+  SimpleTest_Test test(F2);
+
+  Filter nullFilter;
+  Filter filter;
+  filter.skipByName("F4");
+
+  CallForest forest;
+  forest.build(mapping, functions.size());
+
+  for (int distance : {0, 1, 5}) {
+    for (Filter *currentFilter : {&nullFilter, &filter}) {
+      auto actual = forest.createTestees(functions, &test, distance, *currentFilter);
+
+      /// The tree consumes the mapping, hence the copy
+      uint32_t mappingCopy[7];
+      std::copy(std::begin(mapping), std::end(mapping), std::begin(mappingCopy));
+      auto callTree = DynamicCallTree::createCallTree(mappingCopy, functions);
+      auto subtrees = DynamicCallTree::extractTestSubtrees(callTree.get(), &test);
+      auto expected = DynamicCallTree::createTestees(subtrees, &test, distance, *currentFilter);
+
+      expectSameTestees(expected, actual);
+    }
+  }
+
+  /// The forest can be reused for another test
+  uint32_t emptyMapping[7] = {0};
+  forest.build(emptyMapping, functions.size());
+  ASSERT_TRUE(forest.createTestees(functions, &test, 5, nullFilter).empty());
+}
@@ -0,0 +1,69 @@
+#include "Instrumentation/ExecutionBudget.h"
+#include "MullModule.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+
+#include "gtest/gtest.h"
+
+#include <limits>
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+static int countBudgetChecks(Function &function) {
+  int checks = 0;
+  for (auto &block : function) {
+    for (auto &instruction : block) {
+      auto call = dyn_cast<CallInst>(&instruction);
+      if (call == nullptr || call->getCalledFunction() == nullptr) {
+        continue;
+      }
+      if (call->getCalledFunction()->getName() == "mull_executionBudgetExceeded") {
+        checks++;
+      }
+    }
+  }
+  return checks;
+}
+
+TEST(ExecutionBudget, insertCounters_producesValidModule) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+
+  ExecutionBudget::insertCounters(llvmModule);
+
+  ASSERT_FALSE(verifyModule(*llvmModule, &errs()));
+}
+
+TEST(ExecutionBudget, insertCounters_countsEntriesAndLoops) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+
+  ExecutionBudget::insertCounters(llvmModule);
+
+  /// 'count_letters' has a loop: one check on the entry and one on the back edge
+  Function *countLetters = llvmModule->getFunction("count_letters");
+  ASSERT_NE(nullptr, countLetters);
+  ASSERT_EQ(2, countBudgetChecks(*countLetters));
+}
+
+TEST(ExecutionBudget, limitFor) {
+  ASSERT_EQ(ExecutionBudget::MinimalLimit, ExecutionBudget::limitFor(0, 10));
+  ASSERT_EQ(uint64_t(50000), ExecutionBudget::limitFor(5000, 10));
+  ASSERT_EQ(std::numeric_limits<uint64_t>::max(),
+            ExecutionBudget::limitFor(std::numeric_limits<uint64_t>::max() / 2, 10));
+}
+
+TEST(ExecutionBudget, arm) {
+  mull_execution_budget_counter = 42;
+  ExecutionBudget::arm(100);
+
+  ASSERT_EQ(uint64_t(0), ExecutionBudget::steps());
+  ASSERT_EQ(uint64_t(100), mull_execution_budget_limit);
+}
@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+
 using namespace mull;
 
 /// The timeout should be long enough to overlive the unit test suite running
@@ -74,6 +76,21 @@ TEST(ForkProcessSandbox, statusTimeout) {
   ASSERT_EQ(result.status, Timedout);
 }
 
+TEST(ForkProcessSandbox, statusTimeout_AfterRestartingTimeout) {
+  ForkProcessSandbox sandbox;
+
+  auto start = std::chrono::steady_clock::now();
+  ExecutionResult result = sandbox.run([&]() {
+    ForkProcessSandbox::restartTimeout(100);
+    sleep(3);
+    return ExecutionStatus::Passed;
+  }, 10 * Timeout);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_EQ(result.status, Timedout);
+  ASSERT_LT(elapsed, std::chrono::milliseconds(Timeout));
+}
+
 TEST(ForkProcessSandbox, statusCrashed) {
   ForkProcessSandbox sandbox;
 
@@ -84,3 +101,77 @@ TEST(ForkProcessSandbox, statusCrashed) {
 
   ASSERT_EQ(result.status, Crashed);
 }
+
+#pragma mark - In-process sandbox
+
+#if defined(__linux__)
+
+TEST(InProcessSandbox, statusPassed) {
+  InProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&]() {
+    return ExecutionStatus::Passed;
+  }, Timeout);
+
+  ASSERT_EQ(result.status, Passed);
+}
+
+TEST(InProcessSandbox, statusTimeout) {
+  InProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&]() {
+    sleep(3);
+    return ExecutionStatus::Passed;
+  }, Timeout);
+
+  ASSERT_EQ(result.status, Timedout);
+}
+
+TEST(InProcessSandbox, statusCrashed) {
+  InProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&]() {
+    abort();
+    return ExecutionStatus::Passed;
+  }, Timeout);
+
+  ASSERT_EQ(result.status, Crashed);
+}
+
+TEST(InProcessSandbox, crashOutsideOfSandboxGoesToPreviousHandler) {
+  ForkProcessSandbox forkSandbox;
+
+  ExecutionResult result = forkSandbox.run([&]() {
+    InProcessSandbox sandbox;
+    sandbox.run([&]() {
+      return ExecutionStatus::Passed;
+    }, Timeout);
+
+    /// The default action terminates the process
+    raise(SIGSEGV);
+    return ExecutionStatus::Passed;
+  }, Timeout);
+
+  ASSERT_EQ(result.status, Crashed);
+}
+
+TEST(InProcessSandbox, survivesSeveralCrashes) {
+  InProcessSandbox sandbox;
+
+  for (int i = 0; i < 3; i++) {
+    ExecutionResult result = sandbox.run([&]() {
+      raise(SIGSEGV);
+      return ExecutionStatus::Passed;
+    }, Timeout);
+
+    ASSERT_EQ(result.status, Crashed);
+  }
+
+  ExecutionResult result = sandbox.run([&]() {
+    return ExecutionStatus::Passed;
+  }, Timeout);
+
+  ASSERT_EQ(result.status, Passed);
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "GoogleTest/GoogleTestRunner.h"
+#include "GoogleTest/GoogleTest_Test.h"
+#include "ForkProcessSandbox.h"
+#include "Toolchain/Compiler.h"
+#include "Toolchain/JITEngine.h"
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <new>
+#include <string>
+
+using namespace mull;
+using namespace llvm;
+
+static const long long Timeout = 1000;
+
+/// The state of the fake Google Test below lives in the test process
+static int fakeRegistrations = 0;
+static bool fakeInitialized = false;
+
+extern "C" void mull_fakeGoogleTest_register() {
+  fakeRegistrations++;
+}
+
+/// Parses the command line only once, like testing::InitGoogleTest does
+extern "C" void mull_fakeGoogleTest_init(std::string *filter, const char **argv) {
+  if (fakeInitialized) {
+    return;
+  }
+  fakeInitialized = true;
+  new (filter) std::string(strchr(argv[1], '=') + 1);
+}
+
+/// Only 'FakeTest.passes' passes, and only when it is registered once
+extern "C" int mull_fakeGoogleTest_run(std::string *filter) {
+  if (fakeRegistrations != 1) {
+    return 1;
+  }
+  return *filter == "FakeTest.passes" ? 0 : 1;
+}
+
+/// The parts of Google Test the runner calls, see GoogleTestRunner
+static const char *fakeGoogleTestSource = R"(
+@_ZN7testing18FLAGS_gtest_filterE = global [64 x i8] zeroinitializer, align 16
+
+declare void @mull_fakeGoogleTest_register()
+declare void @mull_fakeGoogleTest_init(i8*, i8**)
+declare i32 @mull_fakeGoogleTest_run(i8*)
+
+define void @registerTests() {
+  call void @mull_fakeGoogleTest_register()
+  ret void
+}
+
+define void @_ZN7testing14InitGoogleTestEPiPPc(i32*, i8**) {
+  %filter = getelementptr [64 x i8], [64 x i8]* @_ZN7testing18FLAGS_gtest_filterE, i64 0, i64 0
+  call void @mull_fakeGoogleTest_init(i8* %filter, i8** %1)
+  ret void
+}
+
+define i8* @_ZN7testing8UnitTest11GetInstanceEv() {
+  ret i8* null
+}
+
+define i32 @_ZN7testing8UnitTest3RunEv(i8*) {
+  %filter = getelementptr [64 x i8], [64 x i8]* @_ZN7testing18FLAGS_gtest_filterE, i64 0, i64 0
+  %result = call i32 @mull_fakeGoogleTest_run(i8* %filter)
+  ret i32 %result
+}
+
+define void @passes() {
+  ret void
+}
+
+define void @fails() {
+  ret void
+}
+)";
+
+#if defined(__linux__)
+
+TEST(GoogleTestRunner, runsSeveralTestsInProcess) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> machine(
+      EngineBuilder().selectTarget(Triple(), "", "", SmallVector<std::string, 1>()));
+
+  LLVMContext context;
+  SMDiagnostic error;
+  auto module = parseAssemblyString(fakeGoogleTestSource, error, context);
+  ASSERT_NE(nullptr, module);
+
+  Compiler compiler;
+  auto objectFile = compiler.compileModule(module.get(), *machine);
+
+  std::vector<Function *> constructors({ module->getFunction("registerTests") });
+  GoogleTest_Test passing("FakeTest.passes", module->getFunction("passes"),
+                          constructors);
+  GoogleTest_Test failing("FakeTest.fails", module->getFunction("fails"),
+                          constructors);
+
+  fakeRegistrations = 0;
+  fakeInitialized = false;
+
+  GoogleTestRunner runner(*machine);
+  JITEngine jit;
+  TestRunner::ObjectFiles objectFiles({ objectFile.getBinary() });
+  runner.loadProgram(objectFiles, jit);
+
+  /// All the tests of a mutant run against the same program in this process
+  InProcessSandbox sandbox;
+  std::vector<GoogleTest_Test *> tests({ &passing, &failing, &passing });
+  std::vector<ExecutionStatus> statuses;
+  for (auto test : tests) {
+    auto result = sandbox.run([&]() {
+      return runner.runTest(test, jit);
+    }, Timeout);
+    statuses.push_back(result.status);
+  }
+
+  std::vector<ExecutionStatus> expected({ ExecutionStatus::Passed,
+                                          ExecutionStatus::Failed,
+                                          ExecutionStatus::Passed });
+  ASSERT_EQ(expected, statuses);
+  ASSERT_EQ(1, fakeRegistrations);
+}
+
+#endif
@@ -0,0 +1,259 @@
+#include "Instrumentation/Callbacks.h"
+#include "Instrumentation/Instrumentation.h"
+#include "MullModule.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+/// Index of the function's entry block in InstrumentationInfo::blockCoverage
+static uint32_t firstBlockIndex(Module *module, Function *function) {
+  uint32_t index = 0;
+  for (auto &candidate : module->getFunctionList()) {
+    if (candidate.isDeclaration()) {
+      continue;
+    }
+    if (&candidate == function) {
+      break;
+    }
+    index += candidate.getBasicBlockList().size();
+  }
+  return index;
+}
+
+static bool marksBlockAsExecuted(BasicBlock &block) {
+  for (auto &instruction : block) {
+    auto store = dyn_cast<StoreInst>(&instruction);
+    if (store == nullptr) {
+      continue;
+    }
+    auto value = dyn_cast<ConstantInt>(store->getValueOperand());
+    if (value && value->getBitWidth() == 8 && value->isOne()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static int countCallbacks(Module &module) {
+  int callbacks = 0;
+  for (auto &function : module) {
+    for (auto &block : function) {
+      for (auto &instruction : block) {
+        auto call = dyn_cast<CallInst>(&instruction);
+        if (call == nullptr || call->getCalledFunction() == nullptr) {
+          continue;
+        }
+        auto name = call->getCalledFunction()->getName();
+        if (name == "mull_enterFunction" || name == "mull_leaveFunction") {
+          callbacks++;
+        }
+      }
+    }
+  }
+  return callbacks;
+}
+
+TEST(Instrumentation, inlineCallTree_producesValidModuleWithoutCallbacks) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+
+  Instrumentation instrumentation(false, true);
+  instrumentation.recordFunctions(llvmModule);
+  instrumentation.insertCallbacks(llvmModule);
+
+  ASSERT_FALSE(verifyModule(*llvmModule, &errs()));
+  ASSERT_EQ(0, countCallbacks(*llvmModule));
+}
+
+TEST(Instrumentation, blockCoverage_disabledByDefault) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Function *countLetters = module->getModule()->getFunction("count_letters");
+  ASSERT_NE(nullptr, countLetters);
+
+  Instrumentation instrumentation;
+  instrumentation.recordFunctions(module->getModule());
+
+  SimpleTest_Test test(countLetters);
+  instrumentation.setupInstrumentationInfo(&test);
+  ASSERT_EQ(nullptr, test.getInstrumentationInfo().blockCoverage);
+  instrumentation.cleanupInstrumentationInfo(&test);
+}
+
+TEST(Instrumentation, blockCoverage_recordsCoveredBlocks) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+  Function *countLetters = llvmModule->getFunction("count_letters");
+  ASSERT_NE(nullptr, countLetters);
+  ASSERT_GT(countLetters->getBasicBlockList().size(), 1U);
+
+  Instrumentation instrumentation(true);
+  instrumentation.recordFunctions(llvmModule);
+
+  SimpleTest_Test test(countLetters);
+  instrumentation.setupInstrumentationInfo(&test);
+
+  uint8_t *coverage = test.getInstrumentationInfo().blockCoverage;
+  ASSERT_NE(nullptr, coverage);
+  coverage[firstBlockIndex(llvmModule, countLetters)] = 1;
+
+  instrumentation.recordCoveredBlocks(&test);
+  instrumentation.cleanupInstrumentationInfo(&test);
+
+  ASSERT_TRUE(test.coversBlock(&countLetters->getEntryBlock()));
+  ASSERT_FALSE(test.coversBlock(&countLetters->back()));
+}
+
+TEST(Instrumentation, blockCoverage_marksEachBlock) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+
+  Instrumentation instrumentation(true);
+  instrumentation.recordFunctions(llvmModule);
+  instrumentation.insertCallbacks(llvmModule);
+
+  Function *countLetters = llvmModule->getFunction("count_letters");
+  ASSERT_NE(nullptr, countLetters);
+  for (auto &block : *countLetters) {
+    ASSERT_TRUE(marksBlockAsExecuted(block));
+  }
+}
+
+TEST(Instrumentation, buffers_areReusedAndCleared) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+  Function *countLetters = llvmModule->getFunction("count_letters");
+  ASSERT_NE(nullptr, countLetters);
+
+  Instrumentation instrumentation(true);
+  instrumentation.recordFunctions(llvmModule);
+  auto buffers = instrumentation.createBuffers();
+
+  SimpleTest_Test test(countLetters);
+  instrumentation.setupInstrumentationInfo(&test, *buffers);
+  uint32_t *mapping = test.getInstrumentationInfo().callTreeMapping;
+  uint8_t *coverage = test.getInstrumentationInfo().blockCoverage;
+  ASSERT_EQ(buffers->getCallTreeMapping(), mapping);
+  ASSERT_EQ(buffers->getBlockCoverage(), coverage);
+
+  /// The results are read: only the entries found are cleared
+  mapping[1] = 1;
+  coverage[0] = 1;
+  buffers->setTouchedFunctions({ 1 });
+  buffers->setTouchedBlocks({ 0 });
+  instrumentation.cleanupInstrumentationInfo(&test, *buffers);
+  ASSERT_EQ(nullptr, test.getInstrumentationInfo().callTreeMapping);
+  ASSERT_EQ(0U, mapping[1]);
+  ASSERT_EQ(0, coverage[0]);
+
+  /// The results are not read: everything is cleared
+  instrumentation.setupInstrumentationInfo(&test, *buffers);
+  ASSERT_EQ(mapping, test.getInstrumentationInfo().callTreeMapping);
+  mapping[1] = 1;
+  coverage[0] = 1;
+  instrumentation.cleanupInstrumentationInfo(&test, *buffers);
+  ASSERT_EQ(0U, mapping[1]);
+  ASSERT_EQ(0, coverage[0]);
+}
+
+TEST(Instrumentation, callCounts_recordsCountsOfCalledFunctions) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+  Function *countLetters = llvmModule->getFunction("count_letters");
+  ASSERT_NE(nullptr, countLetters);
+
+  Instrumentation instrumentation(false, false, true);
+  instrumentation.recordFunctions(llvmModule);
+  auto buffers = instrumentation.createBuffers();
+  ASSERT_NE(nullptr, buffers->getCallCounts());
+
+  SimpleTest_Test test(countLetters);
+  instrumentation.setupInstrumentationInfo(&test, *buffers);
+
+  auto &functions = instrumentation.getFunctions();
+  auto position = std::find_if(functions.begin(), functions.end(),
+                               [&](const CallTreeFunction &function) {
+                                 return function.function == countLetters;
+                               });
+  ASSERT_NE(functions.end(), position);
+  uint32_t index = position - functions.begin();
+  test.getInstrumentationInfo().callTreeMapping[index] = index;
+  test.getInstrumentationInfo().callCounts[index] = 1000;
+
+  CallForest forest;
+  forest.build(test.getInstrumentationInfo().callTreeMapping,
+               instrumentation.getFunctions().size());
+  instrumentation.recordCallCounts(&test, forest);
+  buffers->setTouchedFunctions(forest.calledFunctions());
+  instrumentation.cleanupInstrumentationInfo(&test, *buffers);
+
+  ASSERT_EQ(1000U, test.getCallCount(countLetters));
+  ASSERT_EQ(0U, buffers->getCallCounts()[index]);
+}
+
+TEST(Instrumentation, callCounts_producesValidModule) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+
+  Instrumentation instrumentation(false, true, true);
+  instrumentation.recordFunctions(llvmModule);
+  instrumentation.insertCallbacks(llvmModule);
+
+  ASSERT_FALSE(verifyModule(*llvmModule, &errs()));
+}
+
+TEST(Instrumentation, callbacks_keepCallStackOfSpawnedThread) {
+  ///
+  /// Call trace
+  ///
+  ///   Test thread:    F1 -> F2 -> F3
+  ///   Spawned thread:       F2 -> F4 -> F5
+
+  uint32_t mapping[6] = { 0 };
+  InstrumentationInfo info;
+  info.callTreeMapping = mapping;
+  InstrumentationInfo *trampoline = nullptr;
+
+  Callbacks::setInstrumentationInfo(&trampoline, &info);
+  auto trampolinePointer = reinterpret_cast<void **>(&trampoline);
+
+  mull_enterFunction(trampolinePointer, 1);
+  mull_enterFunction(trampolinePointer, 2);
+
+  std::thread thread([&]() {
+    mull_enterFunction(trampolinePointer, 4);
+    mull_enterFunction(trampolinePointer, 5);
+    mull_leaveFunction(trampolinePointer, 5);
+    mull_leaveFunction(trampolinePointer, 4);
+  });
+  thread.join();
+
+  /// The spawned thread does not change the test thread's current function
+  ASSERT_EQ(2U, info.currentFunction);
+
+  mull_enterFunction(trampolinePointer, 3);
+  mull_leaveFunction(trampolinePointer, 3);
+  mull_leaveFunction(trampolinePointer, 2);
+  mull_leaveFunction(trampolinePointer, 1);
+
+  ASSERT_EQ(0U, info.currentFunction);
+  ASSERT_EQ(1U, mapping[1]);
+  ASSERT_EQ(1U, mapping[2]);
+  ASSERT_EQ(2U, mapping[3]);
+  ASSERT_EQ(2U, mapping[4]);
+  ASSERT_EQ(4U, mapping[5]);
+}
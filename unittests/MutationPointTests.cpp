@@ -432,7 +432,7 @@ TEST(MutationPoint, SimpleTest_ReplaceCallMutator_applyMutation) {
   ASSERT_TRUE(mutatedTestee != nullptr);
 
   llvm::Instruction &instructionByMutationAddress =
-    mutationPointAddress1.findInstruction(ownedMutatedModule->getModule());
+    ownedMutatedModule->findInstruction(mutationPointAddress1);
 
   ASSERT_TRUE(isa<BinaryOperator>(instructionByMutationAddress));
 }
@@ -473,7 +473,65 @@ TEST(MutationPoint, SimpleTest_ReplaceAssignmentMutator_applyMutation) {
     ASSERT_TRUE(mutatedTestee != nullptr);
 
     llvm::Instruction &instructionByMutationAddress =
-    mutationPointAddress1.findInstruction(ownedMutatedModule->getModule());
+    ownedMutatedModule->findInstruction(mutationPointAddress1);
 
     ASSERT_TRUE(isa<StoreInst>(instructionByMutationAddress));
 }
+
+TEST(MutationPoint, SharesInternedSourceLocations) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Function *testeeFunction = module->getModule()->getFunction("count_letters");
+  ASSERT_NE(nullptr, testeeFunction);
+
+  Instruction *first = &*inst_begin(testeeFunction);
+  Instruction *second = &*std::next(inst_begin(testeeFunction));
+
+  MathAddMutator mutator;
+  SourceLocation location("/tmp", "/tmp/count_letters.c", 7, 3);
+  MutationPoint firstPoint(&mutator, MutationPointAddress(0, 0, 0), first,
+                           module.get(), location);
+  MutationPoint secondPoint(&mutator, MutationPointAddress(0, 0, 1), second,
+                            module.get(), location);
+
+  ASSERT_EQ(module->internString("/tmp/count_letters.c").data(),
+            module->internString(std::string("/tmp/count_letters.c")).data());
+
+  SourceLocation firstLocation = firstPoint.getSourceLocation();
+  ASSERT_EQ("/tmp", firstLocation.directory);
+  ASSERT_EQ("/tmp/count_letters.c", firstLocation.filePath);
+  ASSERT_EQ(7, firstLocation.line);
+  ASSERT_EQ(3, firstLocation.column);
+
+  ASSERT_TRUE(MutationPoint(&mutator, MutationPointAddress(0, 0, 2), second,
+                            module.get(),
+                            SourceLocation::nullSourceLocation())
+                .getSourceLocation().isNull());
+
+  ASSERT_EQ(module->getUniqueIdentifier() + "_0_0_1_" + MathAddMutator::ID,
+            secondPoint.getUniqueIdentifier());
+  ASSERT_EQ("Math Add: replaced + with -", secondPoint.getDiagnostics());
+}
+
+TEST(MutationPoint, FindsInstructionsThroughFunctionIndex) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Module *llvmModule = module->getModule();
+
+  int functionIndex = 0;
+  for (auto &function : llvmModule->getFunctionList()) {
+    ASSERT_EQ(functionIndex, module->getFunctionIndex(&function));
+    ASSERT_EQ(&function, module->getFunction(functionIndex));
+
+    MutationPointAddress::enumerateInstructions(function,
+      [&](Instruction &instruction, int basicBlockIndex, int instructionIndex) {
+        MutationPointAddress address(functionIndex, basicBlockIndex, instructionIndex);
+        ASSERT_EQ(&instruction, &module->findInstruction(address));
+      });
+    functionIndex++;
+  }
+
+  /// Functions added after the module was indexed
+  Function *added = Function::Create(FunctionType::get(Type::getVoidTy(llvmModule->getContext()), false),
+                                     Function::ExternalLinkage, "added", llvmModule);
+  ASSERT_EQ(functionIndex, module->getFunctionIndex(added));
+  ASSERT_EQ(added, module->getFunction(functionIndex));
+}
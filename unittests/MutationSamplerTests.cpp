@@ -0,0 +1,69 @@
+#include "MutationSampler.h"
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+
+TEST(MutationSampler, allocatesProportionally) {
+  auto sizes = MutationSampler::allocate({ 600, 300, 100 }, 100);
+  ASSERT_EQ(std::vector<size_t>({ 60, 30, 10 }), sizes);
+}
+
+TEST(MutationSampler, allocatesAtLeastOneMutantPerStratum) {
+  auto sizes = MutationSampler::allocate({ 97, 1, 1, 1 }, 10);
+  ASSERT_EQ(std::vector<size_t>({ 7, 1, 1, 1 }), sizes);
+}
+
+TEST(MutationSampler, allocatesWholePopulationToLargeSample) {
+  auto sizes = MutationSampler::allocate({ 3, 5 }, 100);
+  ASSERT_EQ(std::vector<size_t>({ 3, 5 }), sizes);
+}
+
+TEST(MutationSampler, estimatesStratifiedScore) {
+  std::vector<SamplingStratum> strata;
+  strata.emplace_back("math_add", "a.bc");
+  strata.back().population = 300;
+  strata.back().executed = 30;
+  strata.back().killed = 30;
+  strata.emplace_back("math_sub", "a.bc");
+  strata.back().population = 100;
+  strata.back().executed = 10;
+  strata.back().killed = 0;
+
+  auto estimate = MutationSampler::estimate(strata);
+  ASSERT_DOUBLE_EQ(0.75, estimate.score);
+  ASSERT_EQ(40U, estimate.executed);
+  ASSERT_LT(estimate.lower, 0.75);
+  ASSERT_GT(estimate.upper, 0.75);
+  ASSERT_GE(estimate.lower, 0.0);
+  ASSERT_LE(estimate.upper, 1.0);
+}
+
+TEST(MutationSampler, narrowsIntervalWithMoreMutants) {
+  std::vector<SamplingStratum> strata;
+  strata.emplace_back("math_add", "a.bc");
+  strata.back().population = 10000;
+  strata.back().executed = 50;
+  strata.back().killed = 40;
+  auto small = MutationSampler::estimate(strata);
+
+  strata.back().executed = 500;
+  strata.back().killed = 400;
+  auto large = MutationSampler::estimate(strata);
+
+  ASSERT_DOUBLE_EQ(small.score, large.score);
+  ASSERT_LT(large.width(), small.width());
+}
+
+TEST(MutationSampler, exactScoreWhenEveryMutantIsRun) {
+  std::vector<SamplingStratum> strata;
+  strata.emplace_back("math_add", "a.bc");
+  strata.back().population = 4;
+  strata.back().executed = 4;
+  strata.back().killed = 3;
+
+  auto estimate = MutationSampler::estimate(strata);
+  ASSERT_DOUBLE_EQ(0.75, estimate.score);
+  ASSERT_DOUBLE_EQ(0.75, estimate.lower);
+  ASSERT_DOUBLE_EQ(0.75, estimate.upper);
+}
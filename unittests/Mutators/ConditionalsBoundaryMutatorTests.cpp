@@ -69,9 +69,9 @@ TEST(ConditionalsBoundaryMutator, applyMutations) {
   std::vector<MutationPoint *> points = finder.getMutationPoints(mullContext, mergedTestees, filter);
 
   for (auto point: points) {
-    Instruction *originalInstruction = &point->getAddress().findInstruction(module);
+    Instruction *originalInstruction = &borrowedModule->findInstruction(point->getAddress());
     point->applyMutation(*mutatedModule);
-    Instruction *mutatedInstruction = &point->getAddress().findInstruction(mutatedModule->getModule());
+    Instruction *mutatedInstruction = &mutatedModule->findInstruction(point->getAddress());
 
     if (ConditionalsBoundaryMutator::isGT(originalInstruction)) {
       ASSERT_TRUE(ConditionalsBoundaryMutator::isGTE(mutatedInstruction));
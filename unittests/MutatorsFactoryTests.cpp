@@ -1,7 +1,13 @@
 #include "Mutators/MutatorsFactory.h"
+#include "MutationPoint.h"
+#include "SourceLocation.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/IR/Module.h>
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <functional>
 #include <vector>
 
@@ -255,3 +261,58 @@ TEST(MutatorsFactory, UniqueMutators) {
     ASSERT_NE(searchResult, mutators.end());
   }
 }
+
+TEST(MutatorsFactory, MutatorsFindPointsOnlyInTheirOpcodes) {
+  TestModuleFactory testModuleFactory;
+  std::vector<std::unique_ptr<MullModule>> modules;
+  modules.push_back(testModuleFactory.create_SimpleTest_CountLetters_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_MathSub_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_NegateCondition_Testee_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_RemoveVoidFunction_Testee_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_ANDORReplacement_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_ScalarValue_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_ReplaceAssignment_Module());
+  modules.push_back(testModuleFactory.create_SimpleTest_ReplaceCall_Module());
+  modules.push_back(testModuleFactory.create_ConditionalsBoundaryMutator_Module());
+
+  MutatorsFactory factory;
+  vector<unique_ptr<Mutator>> mutators = factory.mutators({ "all" });
+  ASSERT_FALSE(mutators.empty());
+
+  int points = 0;
+  for (auto &module : modules) {
+    int functionIndex = 0;
+    for (auto &function : module->getModule()->getFunctionList()) {
+      int basicBlockIndex = 0;
+      for (auto &basicBlock : function.getBasicBlockList()) {
+        int instructionIndex = 0;
+        for (auto &instruction : basicBlock.getInstList()) {
+          auto location = SourceLocation::sourceLocationFromInstruction(&instruction);
+          MutationPointAddress address(functionIndex, basicBlockIndex, instructionIndex);
+
+          for (auto &mutator : mutators) {
+            std::unique_ptr<MutationPoint> point(
+              mutator->getMutationPoint(module.get(), address, &instruction, location));
+            if (!point) {
+              continue;
+            }
+            points++;
+
+            auto opcodes = mutator->getOpcodes();
+            if (opcodes.empty()) {
+              continue;
+            }
+            ASSERT_NE(opcodes.end(), std::find(opcodes.begin(), opcodes.end(),
+                                               instruction.getOpcode()))
+              << mutator->getUniqueIdentifier() << " " << instruction.getOpcodeName();
+          }
+          instructionIndex++;
+        }
+        basicBlockIndex++;
+      }
+      functionIndex++;
+    }
+  }
+
+  ASSERT_LT(0, points);
+}
@@ -0,0 +1,63 @@
+#include "PatternMatcher.h"
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+
+TEST(PatternMatcher, emptyMatchesNothing) {
+  PatternMatcher matcher;
+  ASSERT_TRUE(matcher.empty());
+  ASSERT_FALSE(matcher.matches(""));
+  ASSERT_FALSE(matcher.matches("/usr/include/c++/v1/vector"));
+}
+
+TEST(PatternMatcher, matchesSubstrings) {
+  PatternMatcher matcher;
+  matcher.addPattern("include/c++/v1");
+  matcher.addPattern("gtest");
+  matcher.addPattern("gmock");
+  ASSERT_FALSE(matcher.empty());
+
+  ASSERT_TRUE(matcher.matches("/usr/include/c++/v1/vector"));
+  ASSERT_TRUE(matcher.matches("/src/googletest/gtest/gtest.cc"));
+  ASSERT_TRUE(matcher.matches("gmock"));
+  ASSERT_FALSE(matcher.matches("/usr/include/c++/v2/vector"));
+  ASSERT_FALSE(matcher.matches("/src/gtes/gmoc.cc"));
+  ASSERT_FALSE(matcher.matches(""));
+}
+
+TEST(PatternMatcher, matchesOverlappingSubstrings) {
+  PatternMatcher matcher;
+  matcher.addPattern("abcd");
+  matcher.addPattern("bce");
+  matcher.addPattern("c");
+
+  ASSERT_TRUE(matcher.matches("xxabcex"));
+  ASSERT_TRUE(matcher.matches("c"));
+  ASSERT_FALSE(matcher.matches("abab"));
+
+  PatternMatcher suffixes;
+  suffixes.addPattern("aab");
+  suffixes.addPattern("ab");
+  ASSERT_TRUE(suffixes.matches("aaab"));
+  ASSERT_FALSE(suffixes.matches("aaaa"));
+}
+
+TEST(PatternMatcher, matchesRegularExpressions) {
+  PatternMatcher matcher;
+  matcher.addPattern("regex:^/usr/(local/)?include/");
+  matcher.addPattern("regex:_test\\.cpp$");
+
+  ASSERT_TRUE(matcher.matches("/usr/include/stdio.h"));
+  ASSERT_TRUE(matcher.matches("/usr/local/include/gtest/gtest.h"));
+  ASSERT_TRUE(matcher.matches("/src/sum_test.cpp"));
+  ASSERT_FALSE(matcher.matches("/src/usr/include/stdio.h"));
+  ASSERT_FALSE(matcher.matches("/src/sum_test.cpp.o"));
+}
+
+TEST(PatternMatcher, ignoresInvalidRegularExpressions) {
+  PatternMatcher matcher;
+  matcher.addPattern("regex:(");
+  ASSERT_TRUE(matcher.empty());
+  ASSERT_FALSE(matcher.matches("("));
+}
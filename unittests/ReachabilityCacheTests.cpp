@@ -0,0 +1,106 @@
+#include "ReachabilityCache.h"
+#include "Config.h"
+#include "Context.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "TemporaryDirectory.h"
+#include "TestModuleFactory.h"
+#include "Testee.h"
+
+#include <llvm/IR/Function.h>
+#include <llvm/Support/FileSystem.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+static Config configWithCache(const std::string &cacheDirectory, int distance) {
+  return Config("",
+                "some_project",
+                "SimpleTest",
+                {},
+                {},
+                {},
+                {},
+                {},
+                {},
+                {},
+                Config::Fork::Disabled,
+                Config::DryRunMode::Disabled,
+                Config::FailFastMode::Disabled,
+                Config::UseCache::Yes,
+                Config::EmitDebugInfo::No,
+                Config::Diagnostics::None,
+                MullDefaultTimeoutMilliseconds,
+                distance,
+                cacheDirectory,
+                JunkDetectionConfig::disabled(),
+                ParallelizationConfig::defaultConfig());
+}
+
+TEST(ReachabilityCache, restoresStoredTests) {
+  Context context;
+  context.addModule(TestModuleFactory.create_SimpleTest_CountLetters_Module());
+  Function *countLetters = context.lookupDefinedFunction("count_letters");
+  ASSERT_NE(nullptr, countLetters);
+
+  TemporaryDirectory temporaryDirectory("mull_reachability_cache");
+  std::string cacheDirectory = temporaryDirectory.getPath();
+  Config config = configWithCache(cacheDirectory, 10);
+
+  std::vector<std::unique_ptr<mull::Test>> tests;
+  tests.push_back(make_unique<SimpleTest_Test>(countLetters));
+  mull::Test *test = tests.front().get();
+
+  {
+    ReachabilityCache cache(config, context);
+    ASSERT_FALSE(cache.containsAll(tests));
+
+    ExecutionResult result;
+    result.status = ExecutionStatus::Passed;
+    result.runningTime = 42;
+    test->setExecutionResult(result);
+    test->setCallCounts({ std::make_pair(countLetters, uint64_t(1000000)) });
+
+    std::vector<std::unique_ptr<Testee>> testees;
+    testees.push_back(make_unique<Testee>(countLetters, test, 2));
+    cache.store(test, testees);
+    cache.save();
+  }
+
+  /// The temporary file is renamed into the cache file
+  std::error_code error;
+  size_t files = 0;
+  for (sys::fs::recursive_directory_iterator it(cacheDirectory, error), end;
+       it != end && !error; it.increment(error)) {
+    if (!sys::fs::is_directory(it->path())) {
+      files++;
+    }
+  }
+  ASSERT_EQ(1U, files);
+
+  {
+    ReachabilityCache cache(config, context);
+    ASSERT_TRUE(cache.containsAll(tests));
+
+    test->setExecutionResult(ExecutionResult());
+    test->setCallCounts({});
+    std::vector<std::unique_ptr<Testee>> testees;
+    ASSERT_TRUE(cache.restore(test, testees));
+
+    ASSERT_EQ(ExecutionStatus::Passed, test->getExecutionResult().status);
+    ASSERT_EQ(42, test->getExecutionResult().runningTime);
+    ASSERT_EQ(1U, testees.size());
+    ASSERT_EQ(countLetters, testees.front()->getTesteeFunction());
+    ASSERT_EQ(test, testees.front()->getTest());
+    ASSERT_EQ(2, testees.front()->getDistance());
+    ASSERT_EQ(1000000U, test->getCallCount(countLetters));
+  }
+
+  /// A different max distance leads to different call trees
+  Config otherConfig = configWithCache(cacheDirectory, 5);
+  ReachabilityCache cache(otherConfig, context);
+  ASSERT_FALSE(cache.containsAll(tests));
+}
@@ -0,0 +1,118 @@
+#include "MutantCostModel.h"
+#include "MutationPoint.h"
+#include "Mutators/MathAddMutator.h"
+#include "Mutators/MathSubMutator.h"
+#include "RunPlanner.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Module.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+class RunPlannerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+    Function *function = module->getModule()->getFunction("count_letters");
+    ASSERT_NE(nullptr, function);
+    instruction = &*inst_begin(function);
+
+    test = make_unique<SimpleTest_Test>(function);
+    ExecutionResult result;
+    result.status = ExecutionStatus::Passed;
+    result.runningTime = 100;
+    test->setExecutionResult(result);
+
+    auto tests = std::make_shared<std::vector<mull::Test *>>();
+    tests->push_back(test.get());
+    auto row = std::make_shared<ReachableTests>(tests);
+    row->add(0, 1);
+    reachableTests = row;
+  }
+
+  MutationPoint *addPoint(Mutator *mutator) {
+    int index = points.size();
+    points.push_back(make_unique<MutationPoint>(mutator,
+                                                MutationPointAddress(0, 0, index),
+                                                instruction, module.get(),
+                                                SourceLocation::nullSourceLocation()));
+    points.back()->setReachableTests(reachableTests);
+    return points.back().get();
+  }
+
+  std::unique_ptr<MullModule> module;
+  Instruction *instruction;
+  std::unique_ptr<SimpleTest_Test> test;
+  std::shared_ptr<const ReachableTests> reachableTests;
+  std::vector<std::unique_ptr<MutationPoint>> points;
+  MathAddMutator mathAdd;
+  MathSubMutator mathSub;
+};
+
+TEST_F(RunPlannerTest, coversEveryMutatorBeforeTheSecondMutant) {
+  std::vector<MutationPoint *> mutants = {
+    addPoint(&mathAdd), addPoint(&mathAdd), addPoint(&mathAdd), addPoint(&mathSub)
+  };
+
+  MutantCostModel costModel;
+  double cost = costModel.cost(mutants.front());
+  ASSERT_DOUBLE_EQ(100 + costModel.compileTime(mutants.front()), cost);
+
+  RunPlanner planner(mutants, costModel, 1);
+  auto chunk = planner.nextChunk(4 * 2.5 * cost, 10);
+  ASSERT_EQ(2U, chunk.size());
+  ASSERT_EQ(&mathAdd, chunk[0]->getMutator());
+  ASSERT_EQ(&mathSub, chunk[1]->getMutator());
+  ASSERT_EQ(2U, planner.remaining().size());
+}
+
+TEST_F(RunPlannerTest, correctsPredictionsByActualTime) {
+  std::vector<MutationPoint *> mutants = {
+    addPoint(&mathAdd), addPoint(&mathAdd), addPoint(&mathAdd), addPoint(&mathAdd)
+  };
+
+  MutantCostModel costModel;
+  double cost = costModel.cost(mutants.front());
+
+  RunPlanner planner(mutants, costModel, 2);
+  auto chunk = planner.nextChunk(4 * cost, 10);
+  ASSERT_EQ(2U, chunk.size());
+
+  /// The chunk took twice as long as predicted
+  planner.calibrate(2 * cost);
+  ASSERT_DOUBLE_EQ(2, planner.getCalibration());
+
+  chunk = planner.nextChunk(cost, 10);
+  ASSERT_EQ(1U, chunk.size());
+
+  chunk = planner.nextChunk(0, 10);
+  ASSERT_TRUE(chunk.empty());
+  ASSERT_EQ(1U, planner.remaining().size());
+}
+
+TEST_F(RunPlannerTest, takesQuarterOfRemainingTimePerChunk) {
+  std::vector<MutationPoint *> mutants = {
+    addPoint(&mathAdd), addPoint(&mathAdd), addPoint(&mathAdd), addPoint(&mathAdd)
+  };
+
+  MutantCostModel costModel;
+  double cost = costModel.cost(mutants.front());
+
+  /// Everything fits, but the predictions are corrected first
+  RunPlanner planner(mutants, costModel, 1);
+  auto chunk = planner.nextChunk(8 * cost, 10);
+  ASSERT_EQ(2U, chunk.size());
+  planner.calibrate(2 * cost);
+
+  /// A mutant longer than a quarter of the time left runs on its own
+  chunk = planner.nextChunk(2 * cost, 10);
+  ASSERT_EQ(1U, chunk.size());
+  ASSERT_EQ(1U, planner.remaining().size());
+}
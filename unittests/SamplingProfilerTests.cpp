@@ -0,0 +1,107 @@
+#include "Context.h"
+#include "Filter.h"
+#include "Instrumentation/Instrumentation.h"
+#include "Instrumentation/SamplingProfiler.h"
+#include "SimpleTest/SimpleTestFinder.h"
+#include "SimpleTest/SimpleTestRunner.h"
+#include "TestModuleFactory.h"
+#include "Toolchain/Compiler.h"
+#include "Toolchain/JITEngine.h"
+
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+TEST(SamplingProfiler, keepFramePointers) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  Function *countLetters = module->getModule()->getFunction("count_letters");
+  ASSERT_NE(nullptr, countLetters);
+
+  SamplingProfiler::keepFramePointers(module->getModule());
+
+  ASSERT_EQ("true", countLetters->getFnAttribute("no-frame-pointer-elim")
+                                .getValueAsString());
+}
+
+TEST(SamplingProfiler, mapsAddressesToFunctions) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                EngineBuilder().selectTarget(Triple(), "", "",
+                                SmallVector<std::string, 1>()));
+
+  Compiler compiler;
+  Context context;
+  context.addModule(TestModuleFactory.create_SimpleTest_CountLettersTest_Module());
+  context.addModule(TestModuleFactory.create_SimpleTest_CountLetters_Module());
+
+  Instrumentation instrumentation;
+  SimpleTestRunner::ObjectFiles objectFiles;
+  SimpleTestRunner::OwnedObjectFiles ownedObjectFiles;
+  for (auto &module : context.getModules()) {
+    instrumentation.recordFunctions(module->getModule());
+    SamplingProfiler::keepFramePointers(module->getModule());
+    auto objectFile = compiler.compileModule(module->getModule(), *targetMachine);
+    objectFiles.push_back(objectFile.getBinary());
+    ownedObjectFiles.push_back(std::move(objectFile));
+  }
+
+  SimpleTestRunner runner(*targetMachine);
+  JITEngine jit;
+  runner.loadProgram(objectFiles, jit);
+
+  SamplingProfiler profiler(instrumentation.getFunctions(), jit);
+
+  auto &functions = instrumentation.getFunctions();
+  Function *countLetters = context.lookupDefinedFunction("count_letters");
+  auto position = std::find_if(functions.begin(), functions.end(),
+                               [&](const CallTreeFunction &function) {
+                                 return function.function == countLetters;
+                               });
+  ASSERT_NE(functions.end(), position);
+  uint32_t countLettersIndex = position - functions.begin();
+
+  std::string name = countLetters->getName().str();
+  char prefix = countLetters->getParent()->getDataLayout().getGlobalPrefix();
+  if (prefix != '\0') {
+    name.insert(name.begin(), prefix);
+  }
+  uint64_t address = llvm_compat::JITSymbolAddress(jit.getSymbol(name));
+  ASSERT_NE(0U, address);
+
+  ASSERT_EQ(countLettersIndex, profiler.functionAt(address));
+  ASSERT_EQ(countLettersIndex, profiler.functionAt(address + 1));
+  ASSERT_EQ(0U, profiler.functionAt(0));
+
+  if (!SamplingProfiler::isSupported()) {
+    return;
+  }
+
+  Filter filter;
+  SimpleTestFinder testFinder;
+  auto tests = testFinder.findTests(context, filter);
+  ASSERT_EQ(1U, tests.size());
+  auto test = tests.front().get();
+
+  auto statistics = SamplingProfiler::createStatistics();
+  instrumentation.setupInstrumentationInfo(test);
+  auto status = profiler.profile(test, [&]() {
+    return runner.runTest(test, jit);
+  }, 1000, *statistics);
+  instrumentation.cleanupInstrumentationInfo(test);
+
+  ASSERT_EQ(ExecutionStatus::Passed, status);
+  ASSERT_LE(1, statistics->runs);
+  ASSERT_GE(SamplingProfiler::MaxRuns, statistics->runs);
+}
@@ -0,0 +1,231 @@
+#include "StaticCallGraph.h"
+#include "Context.h"
+#include "Filter.h"
+#include "MullModule.h"
+#include "GoogleTest/GoogleTest_Test.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "Testee.h"
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static LLVMContext llvmContext;
+
+static std::unique_ptr<MullModule> moduleFromIR(const char *identifier,
+                                                const char *source) {
+  SMDiagnostic error;
+  auto module = parseAssemblyString(source, error, llvmContext);
+  assert(module && "Expected module to be parsed correctly");
+  module->setModuleIdentifier(identifier);
+  return make_unique<MullModule>(std::move(module), "fake_hash", "fake_path");
+}
+
+static const char *testerSource = R"(
+@handlers = global [1 x void (i8*)*] [void (i8*)* @handler]
+
+declare void @leaf()
+
+define void @test() {
+  call void @direct()
+  %handler = load void (i8*)*, void (i8*)** getelementptr ([1 x void (i8*)*], [1 x void (i8*)*]* @handlers, i64 0, i64 0)
+  call void %handler(i8* null)
+  ret void
+}
+
+define void @direct() {
+  call void @leaf()
+  ret void
+}
+
+define void @handler(i8*) {
+  ret void
+}
+)";
+
+static const char *testeeSource = R"(
+@counters = global [1 x void (i32)*] [void (i32)* @counter]
+
+define void @leaf() {
+  ret void
+}
+
+define void @counter(i32) {
+  ret void
+}
+
+define void @unreachable() {
+  ret void
+}
+)";
+
+static std::map<std::string, int> distances(std::vector<std::unique_ptr<Testee>> &testees) {
+  std::map<std::string, int> result;
+  for (auto &testee : testees) {
+    result[testee->getTesteeFunction()->getName().str()] = testee->getDistance();
+  }
+  return result;
+}
+
+TEST(StaticCallGraph, resolvesDirectAndIndirectCalls) {
+  Context context;
+  context.addModule(moduleFromIR("tester", testerSource));
+  context.addModule(moduleFromIR("testee", testeeSource));
+
+  SimpleTest_Test test(context.lookupDefinedFunction("test"));
+  StaticCallGraph callGraph(context);
+  Filter filter;
+
+  auto testees = callGraph.getTestees(&test, filter, 10);
+  std::map<std::string, int> expected = {
+    { "direct", 1 },
+    { "handler", 1 },
+    { "leaf", 2 },
+  };
+  ASSERT_EQ(expected, distances(testees));
+
+  auto nearTestees = callGraph.getTestees(&test, filter, 1);
+  std::map<std::string, int> expectedNear = {
+    { "direct", 1 },
+    { "handler", 1 },
+  };
+  ASSERT_EQ(expectedNear, distances(nearTestees));
+}
+
+TEST(StaticCallGraph, reachableFunctions) {
+  Context context;
+  context.addModule(moduleFromIR("tester", testerSource));
+  context.addModule(moduleFromIR("testee", testeeSource));
+
+  std::vector<std::unique_ptr<mull::Test>> tests;
+  tests.push_back(make_unique<SimpleTest_Test>(context.lookupDefinedFunction("test")));
+
+  StaticCallGraph callGraph(context);
+  auto reachable = callGraph.reachableFunctions(tests);
+
+  ASSERT_EQ(4U, reachable.size());
+  ASSERT_EQ(1U, reachable.count(context.lookupDefinedFunction("test")));
+  ASSERT_EQ(1U, reachable.count(context.lookupDefinedFunction("leaf")));
+  ASSERT_EQ(0U, reachable.count(context.lookupDefinedFunction("counter")));
+  ASSERT_EQ(0U, reachable.count(context.lookupDefinedFunction("unreachable")));
+}
+
+TEST(StaticCallGraph, functionsPassedToExternalCodeAreRoots) {
+  const char *source = R"(
+declare i32 @pthread_create(i8*, i8*, i8* (i8*)*, i8*)
+
+define void @test() {
+  ret void
+}
+
+define void @spawn() {
+  %thread = alloca i8
+  call i32 @pthread_create(i8* %thread, i8* null, i8* (i8*)* @threadEntry, i8* null)
+  ret void
+}
+
+define i8* @threadEntry(i8*) {
+  call void @worker()
+  ret i8* null
+}
+
+define void @worker() {
+  ret void
+}
+
+define void @sorted(i8*) {
+  call void @spawn()
+  %compare = bitcast i8* (i8*)* @compare to i8*
+  call void @sort(i8* %compare)
+  ret void
+}
+
+define void @sort(i8*) {
+  ret void
+}
+
+define i8* @compare(i8*) {
+  ret i8* null
+}
+)";
+
+  Context context;
+  context.addModule(moduleFromIR("module", source));
+
+  SimpleTest_Test test(context.lookupDefinedFunction("test"));
+  StaticCallGraph callGraph(context);
+  Filter filter;
+
+  /// 'compare' is only passed to a function defined in the module
+  auto testees = callGraph.getTestees(&test, filter, 10);
+  std::map<std::string, int> expected = {
+    { "threadEntry", 1 },
+    { "worker", 2 },
+  };
+  ASSERT_EQ(expected, distances(testees));
+}
+
+TEST(StaticCallGraph, virtualMethodsAreNotRoots) {
+  const char *source = R"(
+%class.Test = type { i32 (...)** }
+
+@_ZTV9FirstTest = constant [4 x i8*] [i8* null, i8* null, i8* bitcast (void (%class.Test*)* @_ZN9FirstTest5SetUpEv to i8*), i8* bitcast (void (%class.Test*)* @_ZN9FirstTest8TestBodyEv to i8*)]
+@_ZTV10SecondTest = constant [4 x i8*] [i8* null, i8* null, i8* bitcast (void (%class.Test*)* @_ZN10SecondTest5SetUpEv to i8*), i8* bitcast (void (%class.Test*)* @_ZN10SecondTest8TestBodyEv to i8*)]
+
+define void @_ZN9FirstTest5SetUpEv(%class.Test*) {
+  ret void
+}
+
+define void @_ZN9FirstTest8TestBodyEv(%class.Test*) {
+  call void @first()
+  ret void
+}
+
+define void @_ZN10SecondTest5SetUpEv(%class.Test*) {
+  ret void
+}
+
+define void @_ZN10SecondTest8TestBodyEv(%class.Test*) {
+  call void @second()
+  ret void
+}
+
+define void @first() {
+  ret void
+}
+
+define void @second() {
+  ret void
+}
+)";
+
+  Context context;
+  context.addModule(moduleFromIR("module", source));
+
+  GoogleTest_Test firstTest("FirstTest.TestBody",
+                            context.lookupDefinedFunction("_ZN9FirstTest8TestBodyEv"),
+                            {});
+  GoogleTest_Test secondTest("SecondTest.TestBody",
+                             context.lookupDefinedFunction("_ZN10SecondTest8TestBodyEv"),
+                             {});
+  StaticCallGraph callGraph(context);
+  Filter filter;
+
+  auto firstTestees = callGraph.getTestees(&firstTest, filter, 10);
+  std::map<std::string, int> expectedFirst = {
+    { "first", 1 },
+  };
+  ASSERT_EQ(expectedFirst, distances(firstTestees));
+
+  auto secondTestees = callGraph.getTestees(&secondTest, filter, 10);
+  std::map<std::string, int> expectedSecond = {
+    { "second", 1 },
+  };
+  ASSERT_EQ(expectedSecond, distances(secondTestees));
+}
@@ -0,0 +1,30 @@
+#include "TemporaryDirectory.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <ftw.h>
+#include <vector>
+
+TemporaryDirectory::TemporaryDirectory(const char *prefix) : path() {
+  std::string pattern = std::string("/tmp/") + prefix + ".XXXXXX";
+  std::vector<char> directory(pattern.begin(), pattern.end());
+  directory.push_back('\0');
+  char *created = mkdtemp(directory.data());
+  assert(created && "Expected temporary directory to be created");
+  path = created;
+}
+
+static int removeEntry(const char *entry, const struct stat *, int,
+                       struct FTW *) {
+  return remove(entry);
+}
+
+TemporaryDirectory::~TemporaryDirectory() {
+  /// Depth first: the contents of a directory are removed before it
+  nftw(path.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+const std::string &TemporaryDirectory::getPath() const {
+  return path;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+/// A directory created under /tmp for the duration of a test, removed along
+/// with everything written into it when the object goes out of scope
+class TemporaryDirectory {
+public:
+  explicit TemporaryDirectory(const char *prefix);
+  ~TemporaryDirectory();
+
+  TemporaryDirectory(const TemporaryDirectory &) = delete;
+  TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+  const std::string &getPath() const;
+
+private:
+  std::string path;
+};
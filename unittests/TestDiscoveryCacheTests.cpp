@@ -0,0 +1,68 @@
+#include "TestDiscoveryCache.h"
+#include "Context.h"
+#include "Filter.h"
+#include "SimpleTest/SimpleTestFinder.h"
+#include "TemporaryDirectory.h"
+#include "TestFinder.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/IR/Function.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+TEST(TestDiscoveryCache, restoresStoredModules) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLettersTest_Module();
+  TemporaryDirectory temporaryDirectory("mull_test_discovery_cache");
+  std::string cacheDirectory = temporaryDirectory.getPath();
+
+  DiscoveredModuleTests stored;
+  stored.module = module.get();
+  stored.tests.emplace_back("Suite.some test", "_ZN5Suite8TestBodyEv");
+  stored.constructors.push_back("_GLOBAL__sub_I_test.cpp");
+
+  TestDiscoveryCache cache(cacheDirectory, "SimpleTest");
+  DiscoveredModuleTests restored;
+  restored.module = module.get();
+  ASSERT_FALSE(cache.restore(restored));
+
+  cache.store(stored);
+  ASSERT_TRUE(cache.restore(restored));
+  ASSERT_EQ(1U, restored.tests.size());
+  ASSERT_EQ("Suite.some test", restored.tests.front().name);
+  ASSERT_EQ("_ZN5Suite8TestBodyEv", restored.tests.front().entryPoint);
+  ASSERT_EQ(stored.constructors, restored.constructors);
+
+  /// The tests depend on the finder as well
+  TestDiscoveryCache otherFinderCache(cacheDirectory, "GoogleTest");
+  DiscoveredModuleTests otherFinderTests;
+  otherFinderTests.module = module.get();
+  ASSERT_FALSE(otherFinderCache.restore(otherFinderTests));
+}
+
+TEST(TestDiscoveryCache, findsSameTestsInParallelAndFromCache) {
+  Context context;
+  context.addModule(TestModuleFactory.create_SimpleTest_CountLettersTest_Module());
+  context.addModule(TestModuleFactory.create_SimpleTest_CountLetters_Module());
+
+  Filter filter;
+  TemporaryDirectory temporaryDirectory("mull_test_discovery_cache");
+  std::string cacheDirectory = temporaryDirectory.getPath();
+
+  SimpleTestFinder sequentialFinder;
+  auto expected = sequentialFinder.findTests(context, filter);
+  ASSERT_EQ(1U, expected.size());
+
+  for (int run = 0; run < 2; run++) {
+    SimpleTestFinder finder(2, cacheDirectory);
+    auto tests = finder.findTests(context, filter);
+    ASSERT_EQ(expected.size(), tests.size());
+    ASSERT_EQ(expected.front()->getTestName(), tests.front()->getTestName());
+    ASSERT_EQ(expected.front()->testBodyFunction(),
+              tests.front()->testBodyFunction());
+  }
+}
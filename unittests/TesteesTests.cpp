@@ -1,17 +1,22 @@
 #include "gtest/gtest.h"
 #include "TestModuleFactory.h"
 #include "Testee.h"
+#include "SimpleTest/SimpleTest_Test.h"
 
 TEST(Testees, mergeTestees) {
   TestModuleFactory factory;
   auto module = factory.create_SimpleTest_ANDORReplacement_Module();
   auto &allFunctions = module->getModule()->getFunctionList();
 
+  mull::SimpleTest_Test firstTest(nullptr);
+  mull::SimpleTest_Test secondTest(nullptr);
+  mull::SimpleTest_Test thirdTest(nullptr);
+
   std::vector<std::unique_ptr<Testee>> allTestees;
   for (auto &func : allFunctions) {
-    allTestees.push_back(llvm::make_unique<Testee>(&func, nullptr, 1));
-    allTestees.push_back(llvm::make_unique<Testee>(&func, nullptr, 2));
-    allTestees.push_back(llvm::make_unique<Testee>(&func, nullptr, 3));
+    allTestees.push_back(llvm::make_unique<Testee>(&func, &firstTest, 1));
+    allTestees.push_back(llvm::make_unique<Testee>(&func, &secondTest, 2));
+    allTestees.push_back(llvm::make_unique<Testee>(&func, &thirdTest, 3));
   }
 
   auto mergedTestees = mergeTestees(allTestees);
@@ -22,3 +27,37 @@ TEST(Testees, mergeTestees) {
     ASSERT_EQ(size_t(3), merged.getReachableTests().size());
   }
 }
+
+TEST(Testees, mergeTestees_keepsShortestDistancePerTest) {
+  TestModuleFactory factory;
+  auto module = factory.create_SimpleTest_ANDORReplacement_Module();
+  llvm::Function *function = &module->getModule()->getFunctionList().front();
+
+  mull::SimpleTest_Test firstTest(nullptr);
+  mull::SimpleTest_Test secondTest(nullptr);
+
+  std::vector<std::unique_ptr<Testee>> allTestees;
+  allTestees.push_back(llvm::make_unique<Testee>(function, &firstTest, 3));
+  allTestees.push_back(llvm::make_unique<Testee>(function, &secondTest, 2));
+  allTestees.push_back(llvm::make_unique<Testee>(function, &firstTest, 1));
+
+  auto mergedTestees = mergeTestees(allTestees);
+  ASSERT_EQ(size_t(1), mergedTestees.size());
+
+  auto &reachableTests = mergedTestees.front().getReachableTests();
+  ASSERT_EQ(size_t(2), reachableTests.size());
+
+  std::vector<std::pair<mull::Test *, int>> pairs(reachableTests.begin(),
+                                                  reachableTests.end());
+  ASSERT_EQ(&firstTest, pairs[0].first);
+  ASSERT_EQ(1, pairs[0].second);
+  ASSERT_EQ(&secondTest, pairs[1].first);
+  ASSERT_EQ(2, pairs[1].second);
+
+  auto filtered = reachableTests.filter([&](mull::Test *test) {
+    return test == &secondTest;
+  });
+  ASSERT_EQ(size_t(1), filtered->size());
+  ASSERT_EQ(&secondTest, filtered->begin()->first);
+  ASSERT_EQ(2, filtered->begin()->second);
+}
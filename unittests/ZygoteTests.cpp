@@ -0,0 +1,187 @@
+#include "Zygote.h"
+#include "MullModule.h"
+#include "Test.h"
+#include "TestModuleFactory.h"
+#include "TestRunner.h"
+#include "Toolchain/Compiler.h"
+
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <csignal>
+#include <unistd.h>
+
+using namespace mull;
+using namespace llvm;
+using namespace llvm::object;
+
+static TestModuleFactory TestModuleFactory;
+
+static const long long Timeout = 1100;
+
+namespace {
+
+/// Passes when the program it is run against consists of the object files
+/// it expects, byte for byte
+class ObjectFilesTest : public Test {
+public:
+  enum class Behavior { CompareObjectFiles, Crash };
+
+  ObjectFilesTest(std::vector<std::string> expectedData, Behavior behavior)
+      : Test(TK_SimpleTest), expectedData(std::move(expectedData)),
+        behavior(behavior) {}
+
+  std::string getTestName() override { return "object_files_test"; }
+  std::string getTestDisplayName() override { return getTestName(); }
+  std::string getUniqueIdentifier() override { return getTestName(); }
+  Function *testBodyFunction() override { return nullptr; }
+
+  std::vector<std::string> expectedData;
+  Behavior behavior;
+};
+
+/// Keeps the object files instead of linking them
+class ObjectFilesRunner : public TestRunner {
+public:
+  ObjectFilesRunner(TargetMachine &machine, bool failToLoad)
+      : TestRunner(machine), failToLoad(failToLoad) {}
+
+  void loadInstrumentedProgram(ObjectFiles &objectFiles,
+                               Instrumentation &instrumentation,
+                               JITEngine &jit) override {}
+
+  void loadProgram(ObjectFiles &objectFiles, JITEngine &jit) override {
+    if (failToLoad) {
+      _exit(1);
+    }
+    loaded = objectFiles;
+  }
+
+  ExecutionStatus runTest(Test *test, JITEngine &jit) override {
+    auto objectFilesTest = static_cast<ObjectFilesTest *>(test);
+    if (objectFilesTest->behavior == ObjectFilesTest::Behavior::Crash) {
+      raise(SIGSEGV);
+    }
+
+    printf("%zu object files\n", loaded.size());
+    if (loaded.size() != objectFilesTest->expectedData.size()) {
+      return ExecutionStatus::Failed;
+    }
+    for (size_t i = 0; i < loaded.size(); i++) {
+      if (loaded[i]->getData() != objectFilesTest->expectedData[i]) {
+        return ExecutionStatus::Failed;
+      }
+    }
+    return ExecutionStatus::Passed;
+  }
+
+private:
+  bool failToLoad;
+  ObjectFiles loaded;
+};
+
+class ZygoteTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    InitializeNativeTarget();
+    InitializeNativeTargetAsmPrinter();
+    InitializeNativeTargetAsmParser();
+
+    machine.reset(EngineBuilder().selectTarget(Triple(), "", "",
+                                               SmallVector<std::string, 1>()));
+
+    auto tester = TestModuleFactory.create_SimpleTest_CountLettersTest_Module();
+    auto testee = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+    Compiler compiler;
+    objectFiles.push_back(compiler.compileModule(tester->getModule(), *machine));
+    objectFiles.push_back(compiler.compileModule(testee->getModule(), *machine));
+  }
+
+  std::vector<std::string> dataOf(const TestRunner::ObjectFiles &program) {
+    std::vector<std::string> data;
+    for (auto objectFile : program) {
+      data.push_back(objectFile->getData().str());
+    }
+    return data;
+  }
+
+  std::unique_ptr<TargetMachine> machine;
+  std::vector<OwningBinary<ObjectFile>> objectFiles;
+};
+
+}
+
+TEST_F(ZygoteTest, runsTestsAgainstTransferredObjectFiles) {
+  TestRunner::ObjectFiles program = { objectFiles[0].getBinary(),
+                                      objectFiles[1].getBinary() };
+  ObjectFilesTest test(dataOf(program), ObjectFilesTest::Behavior::CompareObjectFiles);
+  ObjectFilesTest testerOnlyTest(dataOf({ program[0] }),
+                                 ObjectFilesTest::Behavior::CompareObjectFiles);
+  ObjectFilesRunner runner(*machine, false);
+
+  /// The tests are shared with the zygote by pointer: they must not change
+  /// after it is started
+  Zygote zygote(runner);
+  ASSERT_TRUE(zygote.isRunning());
+
+  /// The second program reuses the object file sent with the first one
+  for (int i = 0; i < 2; i++) {
+    ASSERT_TRUE(zygote.loadProgram(program));
+
+    ExecutionResult result;
+    ASSERT_TRUE(zygote.runTest(&test, Timeout, 0, result));
+    ASSERT_EQ(ExecutionStatus::Passed, result.status);
+    ASSERT_EQ(std::string("2 object files\n"), result.stdoutOutput);
+
+    zygote.unloadProgram();
+  }
+
+  zygote.releaseObjectFile(program[1]);
+  program.pop_back();
+  ASSERT_TRUE(zygote.loadProgram(program));
+
+  ExecutionResult result;
+  ASSERT_TRUE(zygote.runTest(&testerOnlyTest, Timeout, 0, result));
+  ASSERT_EQ(ExecutionStatus::Passed, result.status);
+  zygote.unloadProgram();
+}
+
+TEST_F(ZygoteTest, reportsCrashedTests) {
+  TestRunner::ObjectFiles program = { objectFiles[0].getBinary() };
+  ObjectFilesTest test(dataOf(program), ObjectFilesTest::Behavior::Crash);
+  ObjectFilesRunner runner(*machine, false);
+
+  Zygote zygote(runner);
+  ASSERT_TRUE(zygote.loadProgram(program));
+
+  ExecutionResult result;
+  ASSERT_TRUE(zygote.runTest(&test, Timeout, 0, result));
+  ASSERT_EQ(ExecutionStatus::Crashed, result.status);
+
+  /// The host survives the crash of a test
+  ASSERT_TRUE(zygote.runTest(&test, Timeout, 0, result));
+  ASSERT_EQ(ExecutionStatus::Crashed, result.status);
+  zygote.unloadProgram();
+}
+
+TEST_F(ZygoteTest, stopsWhenProgramCannotBeLoaded) {
+  TestRunner::ObjectFiles program = { objectFiles[0].getBinary() };
+  ObjectFilesTest test(dataOf(program), ObjectFilesTest::Behavior::CompareObjectFiles);
+  ObjectFilesRunner runner(*machine, true);
+
+  Zygote zygote(runner);
+  ASSERT_TRUE(zygote.isRunning());
+  ASSERT_FALSE(zygote.loadProgram(program));
+  ASSERT_FALSE(zygote.isRunning());
+
+  /// The caller runs the tests on its own from now on
+  ExecutionResult result;
+  ASSERT_FALSE(zygote.runTest(&test, Timeout, 0, result));
+  ASSERT_FALSE(zygote.loadProgram(program));
+  zygote.unloadProgram();
+  zygote.releaseObjectFile(program[0]);
+}